@@ -0,0 +1,616 @@
+// Benchmarks of serialization backends over synthetic Person/MovieInfo workloads.
+//
+// For each workload and backend it reports time, size of encoded data and number of heap
+// allocations per operation. Backends are Json::serialize/deserialize through Json::Value (dom),
+// Json::write/read (stream) and Binary::serialize/deserialize (binary). Handwritten code which
+// produces exactly the same output is the baseline: through Json::Value for JSON (hand-dom) and
+// Binary::Writer/Reader for binary format (hand-binary).
+//
+// Usage: metastuff_bench [minimal time of each measurement in ms, 200 by default]
+//
+// "long-strings" workload has long movie names, it shows how much time goes to escaping and
+// scanning strings. "scan" rows compare string scanning kernels used by stream backend
+// (see CharScan.h) with their scalar versions. "batch" rows decode parsed array of movies with
+// Json::deserializeBatch and with Json::deserialize of each element.
+//
+// Getters and setters of Person log to std::cout, so std::cout is muted while measuring.
+// Handwritten code accesses Person's data members directly.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+#include <Pool.h>
+#include <SoaVector.h>
+
+#include "BinaryCast.h"
+#include "CharScan.h"
+#include "JsonCast.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "Person.h"
+
+/////////////////// ALLOCATION COUNTING
+
+namespace
+{
+
+std::atomic<std::size_t> allocationCount{ 0 };
+
+// Replacements below are kept out of line: when GCC inlines std::free of operator delete into code
+// which got the pointer from operator new, it reports -Wmismatched-new-delete
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE
+#endif
+
+BENCH_NOINLINE void* countedAlloc(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size != 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void* countedAlignedAlloc(std::size_t size, std::align_val_t alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    void* ptr = _aligned_malloc(size != 0 ? size : 1, align);
+#else
+    // size should be a multiple of alignment
+    void* ptr = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align);
+#endif
+    if (ptr) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void countedFree(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+BENCH_NOINLINE void countedAlignedFree(void* ptr) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* ptr) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { countedFree(ptr); }
+
+// over-aligned types, default versions of these don't call operator new(std::size_t)
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAlignedAlloc(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return countedAlignedAlloc(size, alignment); }
+void operator delete(void* ptr, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+
+/////////////////// WORKLOADS
+
+// Person and MovieInfo are only a few levels deep, so deep nesting is measured with a chain of nodes
+struct Node {
+    int id;
+    std::string label;
+    std::vector<Node> children;
+};
+
+namespace meta
+{
+
+template <>
+constexpr auto registerMembers<Node>()
+{
+    return members(
+        member("id", &Node::id),
+        member("label", &Node::label),
+        member("children", &Node::children)
+    );
+}
+
+}
+
+namespace
+{
+
+Person makePerson(std::size_t critics, std::size_t moviesPerCritic)
+{
+    Person person;
+    person.age = 42;
+    person.name = "Benchmark Person";
+    person.salary = 1234.5f;
+    for (std::size_t i = 0; i < critics; ++i) {
+        auto& movies = person.favouriteMovies["Critic " + std::to_string(i)];
+        for (std::size_t j = 0; j < moviesPerCritic; ++j) {
+            movies.push_back(MovieInfo{ "Movie " + std::to_string(j), static_cast<float>(j % 10) + 0.5f });
+        }
+    }
+    return person;
+}
+
+// movie names are long sentences, each with one char which should be escaped at the end
+Person makeTextPerson(std::size_t critics, std::size_t moviesPerCritic, std::size_t nameLength)
+{
+    static const std::string sentence = "A long and winding story about a person who watched too many movies. ";
+    Person person = makePerson(critics, moviesPerCritic);
+    for (auto& pair : person.favouriteMovies) {
+        for (auto& movie : pair.second) {
+            while (movie.name.size() < nameLength) {
+                movie.name += sentence;
+            }
+            movie.name.resize(nameLength);
+            movie.name += '"';
+        }
+    }
+    return person;
+}
+
+Node makeChain(int depth)
+{
+    Node root;
+    Node* node = &root;
+    for (int i = 0; i < depth; ++i) {
+        node->id = i;
+        node->label = "node " + std::to_string(i);
+        if (i + 1 != depth) {
+            node->children.emplace_back();
+            node = &node->children.back(); // parent is not modified anymore, so pointer stays valid
+        }
+    }
+    return root;
+}
+
+/////////////////// HANDWRITTEN SERIALIZATION
+
+// values are filled in place, appending built values would copy whole subtrees
+void handToValue(const MovieInfo& movie, Json::Value& value)
+{
+    value = Json::Value(Json::objectValue);
+    value["name"] = movie.name;
+    value["rating"] = movie.rating;
+}
+
+void handToValue(const Person& person, Json::Value& value)
+{
+    value = Json::Value(Json::objectValue);
+    value["age"] = person.age;
+    value["name"] = person.name;
+    value["salary"] = person.salary;
+    Json::Value& critics = value["favouriteMovies"];
+    critics = Json::Value(Json::objectValue);
+    for (const auto& pair : person.favouriteMovies) {
+        Json::Value& movies = critics[pair.first];
+        movies = Json::Value(Json::arrayValue);
+        movies.resize(static_cast<Json::ArrayIndex>(pair.second.size()));
+        for (Json::ArrayIndex i = 0; i < movies.size(); ++i) {
+            handToValue(pair.second[i], movies[i]);
+        }
+    }
+}
+
+void handToValue(const Node& node, Json::Value& value)
+{
+    value = Json::Value(Json::objectValue);
+    value["id"] = node.id;
+    value["label"] = node.label;
+    Json::Value& children = value["children"];
+    children = Json::Value(Json::arrayValue);
+    children.resize(static_cast<Json::ArrayIndex>(node.children.size()));
+    for (Json::ArrayIndex i = 0; i < children.size(); ++i) {
+        handToValue(node.children[i], children[i]);
+    }
+}
+
+template <typename T>
+Json::Value handToValue(const T& obj)
+{
+    Json::Value value;
+    handToValue(obj, value);
+    return value;
+}
+
+void handFromValue(MovieInfo& movie, const Json::Value& value)
+{
+    movie.name = value["name"].asString();
+    movie.rating = value["rating"].asFloat();
+}
+
+void handFromValue(Person& person, const Json::Value& value)
+{
+    person.age = value["age"].asInt();
+    person.name = value["name"].asString();
+    person.salary = value["salary"].asFloat();
+    const Json::Value& critics = value["favouriteMovies"];
+    for (auto it = critics.begin(); it != critics.end(); ++it) {
+        auto& movies = person.favouriteMovies[it.name()];
+        movies.resize(it->size());
+        for (Json::ArrayIndex i = 0; i < it->size(); ++i) {
+            handFromValue(movies[i], (*it)[i]);
+        }
+    }
+}
+
+void handFromValue(Node& node, const Json::Value& value)
+{
+    node.id = value["id"].asInt();
+    node.label = value["label"].asString();
+    const Json::Value& children = value["children"];
+    node.children.resize(children.size());
+    for (Json::ArrayIndex i = 0; i < children.size(); ++i) {
+        handFromValue(node.children[i], children[i]);
+    }
+}
+
+void handWriteString(Binary::Writer& writer, const std::string& str)
+{
+    writer.writeVarint(str.size());
+    writer.writeBytes(str.data(), str.size());
+}
+
+void handWriteFloat(Binary::Writer& writer, float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writer.writeFixed32(bits);
+}
+
+void handWrite(Binary::Writer& writer, const MovieInfo& movie)
+{
+    const auto position = writer.beginObject();
+    handWriteString(writer, movie.name);
+    handWriteFloat(writer, movie.rating);
+    writer.endObject(position);
+}
+
+void handWrite(Binary::Writer& writer, const Person& person)
+{
+    const auto position = writer.beginObject();
+    writer.writeZigzag(person.age);
+    handWriteString(writer, person.name);
+    handWriteFloat(writer, person.salary);
+    writer.writeVarint(person.favouriteMovies.size());
+    for (const auto& pair : person.favouriteMovies) {
+        handWriteString(writer, pair.first);
+        writer.writeVarint(pair.second.size());
+        for (const auto& movie : pair.second) {
+            handWrite(writer, movie);
+        }
+    }
+    writer.endObject(position);
+}
+
+void handWrite(Binary::Writer& writer, const Node& node)
+{
+    const auto position = writer.beginObject();
+    writer.writeZigzag(node.id);
+    handWriteString(writer, node.label);
+    writer.writeVarint(node.children.size());
+    for (const auto& child : node.children) {
+        handWrite(writer, child);
+    }
+    writer.endObject(position);
+}
+
+void handReadString(Binary::Reader& reader, std::string& str)
+{
+    const std::size_t size = reader.readCount();
+    str.assign(reader.readBytes(size), size);
+}
+
+float handReadFloat(Binary::Reader& reader)
+{
+    const std::uint32_t bits = reader.readFixed32();
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void handRead(Binary::Reader& reader, MovieInfo& movie)
+{
+    const char* objectEnd = reader.beginObject();
+    handReadString(reader, movie.name);
+    movie.rating = handReadFloat(reader);
+    reader.endObject(objectEnd);
+}
+
+void handRead(Binary::Reader& reader, Person& person)
+{
+    const char* objectEnd = reader.beginObject();
+    person.age = static_cast<int>(reader.readZigzag());
+    handReadString(reader, person.name);
+    person.salary = handReadFloat(reader);
+    const std::size_t critics = reader.readCount();
+    std::string key;
+    for (std::size_t i = 0; i < critics; ++i) {
+        handReadString(reader, key);
+        auto& movies = person.favouriteMovies[key];
+        movies.resize(reader.readCount());
+        for (auto& movie : movies) {
+            handRead(reader, movie);
+        }
+    }
+    reader.endObject(objectEnd);
+}
+
+void handRead(Binary::Reader& reader, Node& node)
+{
+    const char* objectEnd = reader.beginObject();
+    node.id = static_cast<int>(reader.readZigzag());
+    handReadString(reader, node.label);
+    node.children.resize(reader.readCount());
+    for (auto& child : node.children) {
+        handRead(reader, child);
+    }
+    reader.endObject(objectEnd);
+}
+
+/////////////////// MEASUREMENT
+
+using Clock = std::chrono::steady_clock;
+
+std::chrono::nanoseconds minTime = std::chrono::milliseconds(200);
+volatile std::size_t sink; // keeps results of measured operations alive
+
+struct Measurement {
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+// runs op in batches until a batch takes at least minTime
+template <typename F>
+Measurement measure(F&& op)
+{
+    op(); // warm up, buffers which are reused get their capacity
+    std::size_t iterations = 1;
+    for (;;) {
+        const std::size_t allocsBefore = allocationCount.load(std::memory_order_relaxed);
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            op();
+        }
+        const auto elapsed = Clock::now() - start;
+        const std::size_t allocs = allocationCount.load(std::memory_order_relaxed) - allocsBefore;
+        if (elapsed >= minTime) {
+            return { std::chrono::duration<double, std::nano>(elapsed).count() / iterations,
+                static_cast<double>(allocs) / iterations };
+        }
+        const double elapsedNs = static_cast<double>(std::max<Clock::rep>(elapsed.count(), 1));
+        const double scale = static_cast<double>(minTime.count()) / elapsedNs * 1.2;
+        iterations = std::max(iterations * 2, static_cast<std::size_t>(iterations * std::min(scale, 100.0)));
+    }
+}
+
+void printHeader()
+{
+    std::printf("%-14s %-12s %-7s %14s %12s %12s\n", "workload", "backend", "op", "ns/op", "bytes/op", "allocs/op");
+}
+
+void printRow(const char* workload, const char* backend, const char* op, const Measurement& m, std::size_t bytes)
+{
+    if (bytes != 0) {
+        std::printf("%-14s %-12s %-7s %14.1f %12zu %12.2f\n", workload, backend, op, m.nsPerOp, bytes, m.allocsPerOp);
+    } else {
+        std::printf("%-14s %-12s %-7s %14.1f %12s %12.2f\n", workload, backend, op, m.nsPerOp, "-", m.allocsPerOp);
+    }
+}
+
+std::string writeValue(const Json::Value& value)
+{
+    Json::FastWriter writer;
+    writer.omitEndingLineFeed();
+    return writer.write(value);
+}
+
+Json::Value parseValue(const std::string& text)
+{
+    Json::Value value;
+    Json::Reader reader;
+    if (!reader.parse(text, value)) {
+        std::fprintf(stderr, "can't parse benchmark JSON\n");
+        std::exit(1);
+    }
+    return value;
+}
+
+// handwritten code must produce the same output as backends, otherwise comparison is meaningless
+void checkSame(const char* workload, const char* what, const std::string& expected, const std::string& actual)
+{
+    if (expected != actual) {
+        std::fprintf(stderr, "%s: handwritten %s output differs from library output\n", workload, what);
+        std::exit(1);
+    }
+}
+
+template <typename T>
+void runWorkload(const char* workload, const T& obj)
+{
+    const std::string json = Json::writeToString(obj);
+    const std::string binary = Binary::serialize(obj);
+    {
+        std::string handBinary;
+        Binary::Writer writer(handBinary);
+        handWrite(writer, obj);
+        checkSame(workload, "binary", binary, handBinary);
+        checkSame(workload, "JSON", json, writeValue(handToValue(obj)));
+        checkSame(workload, "dom JSON", json, writeValue(Json::serialize(obj)));
+    }
+
+    std::string out;
+    printRow(workload, "dom", "encode", measure([&obj]() { sink = writeValue(Json::serialize(obj)).size(); }), json.size());
+    printRow(workload, "stream", "encode", measure([&obj, &out]()
+    {
+        out.clear();
+        Json::write(out, obj);
+        sink = out.size();
+    }), json.size());
+    printRow(workload, "hand-dom", "encode", measure([&obj]() { sink = writeValue(handToValue(obj)).size(); }), json.size());
+    printRow(workload, "binary", "encode", measure([&obj, &out]()
+    {
+        out.clear();
+        Binary::serialize(out, obj);
+        sink = out.size();
+    }), binary.size());
+    printRow(workload, "hand-binary", "encode", measure([&obj, &out]()
+    {
+        out.clear();
+        Binary::Writer writer(out);
+        handWrite(writer, obj);
+        sink = out.size();
+    }), binary.size());
+
+    printRow(workload, "dom", "decode", measure([&json]()
+    {
+        const T decoded = Json::deserialize<T>(parseValue(json));
+        sink = sizeof(decoded);
+    }), json.size());
+    printRow(workload, "stream", "decode", measure([&json]()
+    {
+        T decoded{};
+        Json::read(decoded, json);
+        sink = sizeof(decoded);
+    }), json.size());
+    meta::pool<T> clearingPool; // containers are cleared, their elements are decoded again from scratch
+    printRow(workload, "pool-clear", "decode", measure([&json, &clearingPool]()
+    {
+        const auto decoded = clearingPool.acquire();
+        Json::read(*decoded, json);
+        sink = sizeof(*decoded);
+    }), json.size());
+    meta::pool<T> keepingPool(64, meta::reset_policy::keepElements); // elements keep storage of previous decode
+    printRow(workload, "pool-keep", "decode", measure([&json, &keepingPool]()
+    {
+        const auto decoded = keepingPool.acquire();
+        Json::read(*decoded, json);
+        sink = sizeof(*decoded);
+    }), json.size());
+    printRow(workload, "hand-dom", "decode", measure([&json]()
+    {
+        T decoded{};
+        handFromValue(decoded, parseValue(json));
+        sink = sizeof(decoded);
+    }), json.size());
+    printRow(workload, "binary", "decode", measure([&binary]()
+    {
+        const T decoded = Binary::deserialize<T>(binary);
+        sink = sizeof(decoded);
+    }), binary.size());
+    printRow(workload, "hand-binary", "decode", measure([&binary]()
+    {
+        T decoded{};
+        Binary::Reader reader(binary.data(), binary.data() + binary.size());
+        handRead(reader, decoded);
+        reader.finish();
+        sink = sizeof(decoded);
+    }), binary.size());
+}
+
+void runMemberAccess()
+{
+    Person person = makePerson(0, 0);
+    printRow("access", "meta", "get", measure([&person]() { sink = static_cast<std::size_t>(meta::getMemberValue<float>(person, "salary")); }), 0);
+    printRow("access", "direct", "get", measure([&person]() { sink = static_cast<std::size_t>(person.salary); }), 0);
+    printRow("access", "meta", "set", measure([&person]()
+    {
+        meta::setMemberValue<float>(person, "salary", static_cast<float>(sink));
+        sink = static_cast<std::size_t>(person.salary);
+    }), 0);
+    printRow("access", "direct", "set", measure([&person]()
+    {
+        person.salary = static_cast<float>(sink);
+        sink = static_cast<std::size_t>(person.salary);
+    }), 0);
+    printRow("access", "meta", "getter", measure([&person]() { sink = meta::getMemberValue<std::string>(person, "name").size(); }), 0);
+}
+
+void runBatch(std::size_t count)
+{
+    std::vector<MovieInfo> movies;
+    for (std::size_t i = 0; i < count; ++i) {
+        movies.push_back(MovieInfo{ "Movie " + std::to_string(i), static_cast<float>(i % 10) + 0.5f });
+    }
+    const Json::Value array = Json::serialize(movies);
+    const std::size_t bytes = writeValue(array).size();
+    printRow("batch", "per-element", "decode", measure([&array]()
+    {
+        std::vector<MovieInfo> decoded;
+        Json::deserialize(decoded, array); // elements are built one by one and appended
+        sink = decoded.size();
+    }), bytes);
+    printRow("batch", "batch", "decode", measure([&array]()
+    {
+        std::vector<MovieInfo> decoded;
+        Json::deserializeBatch(decoded, array);
+        sink = decoded.size();
+    }), bytes);
+    printRow("batch", "batch-soa", "decode", measure([&array]()
+    {
+        meta::soa_vector<MovieInfo> decoded;
+        Json::deserializeBatch(decoded, array);
+        sink = decoded.size();
+    }), bytes);
+}
+
+void runCharScan()
+{
+    std::string text;
+    while (text.size() < 64 * 1024) {
+        text += "Plain text without anything to escape, as in most of string members. ";
+    }
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    const char* simd = CharScan::instructionSet();
+    printRow("scan", simd, "escape", measure([begin, end]() { sink = CharScan::findEscaped(begin, end) - begin; }), text.size());
+    printRow("scan", "scalar", "escape", measure([begin, end]() { sink = CharScan::findEscapedScalar(begin, end) - begin; }), text.size());
+    printRow("scan", simd, "quote", measure([begin, end]() { sink = CharScan::findQuoteOrEscape(begin, end) - begin; }), text.size());
+    printRow("scan", "scalar", "quote", measure([begin, end]() { sink = CharScan::findQuoteOrEscapeScalar(begin, end) - begin; }), text.size());
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) {
+        minTime = std::chrono::milliseconds(std::atol(argv[1]));
+    }
+    const Person small = makePerson(2, 2);
+    const Person hugeMap = makePerson(10000, 3);
+    const Person longStrings = makeTextPerson(100, 10, 200);
+    const Node deep = makeChain(100);
+
+    std::streambuf* coutBuffer = std::cout.rdbuf(nullptr); // mutes logging in Person's getters and setters
+    printHeader();
+    runWorkload("small", small);
+    runWorkload("huge-map", hugeMap);
+    runWorkload("long-strings", longStrings);
+    runWorkload("deep", deep);
+    runBatch(100000);
+    runMemberAccess();
+    runCharScan();
+    std::cout.rdbuf(coutBuffer);
+    std::cout.clear();
+}
@@ -0,0 +1,158 @@
+#include "BinaryCast.h"
+
+#include <stdexcept>
+
+namespace Binary
+{
+
+void Writer::writeVarint(std::uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void Writer::writeZigzag(std::int64_t value)
+{
+    writeVarint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+void Writer::writeFixed32(std::uint32_t value)
+{
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    out.append(bytes, sizeof(bytes));
+}
+
+void Writer::writeFixed64(std::uint64_t value)
+{
+    char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    out.append(bytes, sizeof(bytes));
+}
+
+std::size_t Writer::beginObject()
+{
+    const std::size_t position = out.size();
+    out.append(4, '\0'); // patched by endObject
+    return position;
+}
+
+void Writer::endObject(std::size_t position)
+{
+    const std::size_t length = out.size() - position - 4;
+    if (length > UINT32_MAX) {
+        throw std::runtime_error("Error: object is too big for binary serialization");
+    }
+    for (int i = 0; i < 4; ++i) {
+        out[position + i] = static_cast<char>(length >> (8 * i));
+    }
+}
+
+std::uint8_t Reader::readByte()
+{
+    if (cur == end) {
+        error("unexpected end of data");
+    }
+    return static_cast<std::uint8_t>(*cur++);
+}
+
+std::uint64_t Reader::readVarint()
+{
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        const std::uint8_t byte = readByte();
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    error("varint is too long");
+}
+
+std::int64_t Reader::readZigzag()
+{
+    const std::uint64_t value = readVarint();
+    return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+std::uint32_t Reader::readFixed32()
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(readBytes(4));
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+std::uint64_t Reader::readFixed64()
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(readBytes(8));
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+const char* Reader::readBytes(std::size_t size)
+{
+    if (static_cast<std::size_t>(end - cur) < size) {
+        error("unexpected end of data");
+    }
+    const char* data = cur;
+    cur += size;
+    return data;
+}
+
+std::size_t Reader::readCount()
+{
+    const std::uint64_t count = readVarint();
+    if (count > static_cast<std::uint64_t>(end - cur)) {
+        error("collection size is bigger than remaining data");
+    }
+    return static_cast<std::size_t>(count);
+}
+
+const char* Reader::beginObject()
+{
+    const std::uint32_t length = readFixed32();
+    if (length > static_cast<std::size_t>(end - cur)) {
+        error("object length is bigger than remaining data");
+    }
+    if (++depth > maxDepth) {
+        error("too deeply nested");
+    }
+    return cur + length;
+}
+
+void Reader::endObject(const char* objectEnd)
+{
+    if (cur > objectEnd) {
+        error("object members are longer than object");
+    }
+    --depth;
+    cur = objectEnd;
+}
+
+void Reader::finish()
+{
+    if (cur != end) {
+        error("unexpected data after value");
+    }
+}
+
+void Reader::error(const char* what) const
+{
+    throw std::runtime_error(std::string("Error: can't deserialize binary data at offset ") +
+        std::to_string(cur - begin) + ": " + what);
+}
+
+}
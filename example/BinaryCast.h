@@ -0,0 +1,165 @@
+// Compact binary serialization of registered classes, drop-in alternative to JsonCast.
+//
+// Format (all multi-byte values are little-endian):
+// - bool: 1 byte
+// - signed integers: zigzag varint, unsigned integers: varint (LEB128)
+// - float, double: 4 or 8 bytes IEEE 754
+// - strings (std::basic_string<char> with any allocator): varint length + bytes
+// - std::vector<T>: varint count + elements. If T is raw serializable (see below), elements are
+//   written as raw fixed-width values instead
+// - std::unordered_map<K, V>: varint count + (key, value) pairs
+// - registered class: 4 byte length + members in registration order, without names or tags.
+//   Length lets readers skip objects and tolerate classes which got new members at the end:
+//   missing trailing members are left untouched, unknown trailing bytes are skipped.
+//
+// Raw serializable types are integers except bool, enums, float, double and registered classes
+// whose members are all raw serializable data members without padding (see meta::isTriviallyPacked).
+// Raw form of a value is its sizeof(T) bytes, little-endian, members in registration order.
+// When members are also laid out in memory in registration order (checked once per class) and
+// host is little-endian, raw form is the same as object representation, so vectors of such
+// types are written and read with a single memcpy.
+// There's no per-element length in raw form, so adding members to such class breaks old data.
+//
+// Big containers are serialized in parallel when ThreadPool::Scope is active, see ThreadPool.h.
+//
+// Deserialization follows the rules of Json::deserialize(obj, value, Json::inPlace):
+// members are read through references when possible and containers keep their storage.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <Archive.h>
+#include <Meta.h>
+#include <LazyView.h>
+#include "MemoryResource.h"
+#include "StringCast.h"
+#include "ThreadPool.h"
+
+namespace Binary
+{
+
+// Appends encoded values to std::string which is used as a byte buffer
+class Writer {
+public:
+    explicit Writer(std::string& out) : out(out) { }
+
+    void writeByte(std::uint8_t value) { out.push_back(static_cast<char>(value)); }
+    void writeVarint(std::uint64_t value);
+    void writeZigzag(std::int64_t value);
+    void writeFixed32(std::uint32_t value);
+    void writeFixed64(std::uint64_t value);
+    void writeBytes(const char* data, std::size_t size) { out.append(data, size); }
+
+    // reserves space for object length, returns position to pass to endObject
+    std::size_t beginObject();
+    void endObject(std::size_t position);
+
+    std::size_t size() const { return out.size(); }
+    // drops everything written after size() was equal to 'size'
+    void truncate(std::size_t size) { out.resize(size); }
+private:
+    std::string& out;
+};
+
+// Reads values from a buffer it doesn't own, throws std::runtime_error on truncated or bad input.
+// Objects nested deeper than maxDepth (recursive classes like trees) are rejected
+class Reader {
+public:
+    static constexpr unsigned maxDepth = 1000;
+
+    Reader(const char* begin, const char* end) : begin(begin), cur(begin), end(end), depth(0) { }
+
+    std::uint8_t readByte();
+    std::uint64_t readVarint();
+    std::int64_t readZigzag();
+    std::uint32_t readFixed32();
+    std::uint64_t readFixed64();
+    // returns pointer to next 'size' bytes and skips them
+    const char* readBytes(std::size_t size);
+    // reads collection size, checks that there's at least one byte per element left
+    std::size_t readCount();
+
+    // reads object length, returns pointer to the end of object
+    const char* beginObject();
+    bool atEnd(const char* objectEnd) const { return cur >= objectEnd; }
+    // skips unknown trailing members
+    void endObject(const char* objectEnd);
+
+    void finish(); // throws if there's anything left
+    std::size_t offset() const { return cur - begin; }
+    const char* position() const { return cur; }
+    std::size_t remaining() const { return end - cur; }
+    [[noreturn]] void error(const char* what) const;
+private:
+    const char* begin;
+    const char* cur;
+    const char* end;
+    unsigned depth;
+};
+
+/////////////////// ENTRY POINTS
+
+template <typename Class>
+std::string serialize(const Class& obj);
+
+// appends encoded obj to out
+template <typename Class>
+void serialize(std::string& out, const Class& obj);
+
+// Classes with registered constructor are built with meta::constructFrom, see LazyView.h
+template <typename Class>
+Class deserialize(std::string_view data);
+
+template <typename Class>
+void deserialize(Class& obj, std::string_view data);
+
+// Class is constructed with resource, see MemoryResource.h
+template <typename Class>
+Class deserialize(std::string_view data, std::pmr::memory_resource* resource);
+
+/////////////////// VALUES
+
+// registered classes, bools, numbers, strings, std::vector and std::unordered_map,
+// written through meta::Archive (see detail::WriterArchive)
+template <typename T>
+void writeValue(Writer& writer, const T& obj);
+
+template <typename T>
+void readValue(Reader& reader, T& obj);
+
+// New elements of classes which have registered constructor and no default one are built with
+// meta::constructFrom, existing elements are decoded in place
+template <typename T, typename A>
+void readValue(Reader& reader, std::vector<T, A>& obj);
+
+template <typename K, typename V, typename H, typename E, typename A>
+void readValue(Reader& reader, std::unordered_map<K, V, H, E, A>& obj);
+
+// skips encoded value of type T without decoding it, objects are skipped by their length
+template <typename T>
+void skipValue(Reader& reader);
+
+/////////////////// LAZY VIEWS
+
+// Format for meta::lazy_view, see LazyView.h. Members missing at the end of object
+// (written by older version of the class) are treated as missing
+struct LazyFormat {
+    template <typename Class, std::size_t N>
+    static void findMembers(std::string_view data, std::array<std::string_view, N>& spans);
+
+    template <typename T>
+    static void decode(std::string_view encoded, T& value);
+};
+
+template <typename Class>
+using LazyView = meta::lazy_view<Class, LazyFormat>;
+
+}
+
+#include "BinaryCast.inl"
@@ -0,0 +1,559 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace Binary
+{
+
+/////////////////// ENTRY POINTS
+
+template <typename Class>
+std::string serialize(const Class& obj)
+{
+    std::string out;
+    serialize(out, obj);
+    return out;
+}
+
+template <typename Class>
+void serialize(std::string& out, const Class& obj)
+{
+    Writer writer(out);
+    writeValue(writer, obj);
+}
+
+template <typename Class>
+Class deserialize(std::string_view data)
+{
+    if constexpr (meta::ctorRegistered<Class>()) {
+        return meta::constructFrom<Class, LazyFormat>(data);
+    } else {
+        Class c;
+        deserialize(c, data);
+        return c;
+    }
+}
+
+template <typename Class>
+void deserialize(Class& obj, std::string_view data)
+{
+    Reader reader(data.data(), data.data() + data.size());
+    readValue(reader, obj);
+    reader.finish();
+}
+
+template <typename Class>
+Class deserialize(std::string_view data, std::pmr::memory_resource* resource)
+{
+    Class c = makeWithResource<Class>(resource);
+    deserialize(c, data);
+    return c;
+}
+
+/////////////////// SERIALIZATION
+
+namespace detail
+{
+
+template <typename T>
+struct dependent_false : std::false_type { };
+
+// see description of raw form in BinaryCast.h
+template <typename T, typename = void>
+struct is_raw_serializable : std::integral_constant<bool,
+    (std::is_integral<T>::value && !std::is_same<T, bool>::value) || std::is_enum<T>::value ||
+    std::is_same<T, float>::value || std::is_same<T, double>::value> { };
+
+template <typename TupleType>
+struct members_are_raw_serializable : std::false_type { };
+
+template <typename... Members>
+struct members_are_raw_serializable<std::tuple<Members...>> : std::integral_constant<bool,
+    (is_raw_serializable<meta::get_member_type<Members>>::value && ...)> { };
+
+template <typename T>
+struct is_raw_serializable<T, std::enable_if_t<meta::isRegistered<T>()>> : std::integral_constant<bool,
+    meta::isTriviallyPacked<T>() &&
+    members_are_raw_serializable<decltype(meta::registerMembers<T>())>::value> { };
+
+inline bool isLittleEndianHost()
+{
+    const std::uint16_t one = 1;
+    unsigned char firstByte;
+    std::memcpy(&firstByte, &one, 1);
+    return firstByte == 1;
+}
+
+// Check if object representation of raw serializable T is the same as its raw form
+template <typename T>
+bool hasNativeRawLayout()
+{
+    if constexpr (meta::isRegistered<T>()) {
+        static const bool native = []()
+        {
+            if constexpr (std::is_default_constructible<T>::value) {
+                const T probe{};
+                const char* base = reinterpret_cast<const char*>(&probe);
+                std::size_t offset = 0;
+                bool inOrder = true;
+                meta::doForAllMembers<T>(
+                    [&probe, base, &offset, &inOrder](const auto& member)
+                    {
+                        using MemberT = meta::get_member_type<decltype(member)>;
+                        const char* address = reinterpret_cast<const char*>(&member.get(probe));
+                        inOrder = inOrder && address == base + offset && hasNativeRawLayout<MemberT>();
+                        offset += sizeof(MemberT);
+                    }
+                );
+                return inOrder;
+            } else {
+                return false; // can't get member offsets without an object, raw form is written member by member
+            }
+        }();
+        return native;
+    } else {
+        return isLittleEndianHost();
+    }
+}
+
+template <typename T>
+void writeRaw(Writer& writer, const T& obj)
+{
+    if constexpr (meta::isRegistered<T>()) {
+        meta::doForAllMembers<T>(
+            [&writer, &obj](const auto& member)
+            {
+                writeRaw(writer, member.get(obj));
+            }
+        );
+    } else {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &obj, sizeof(T));
+        if (!isLittleEndianHost()) {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        writer.writeBytes(bytes, sizeof(T));
+    }
+}
+
+// Calls writeAt(chunkWriter, i) for i in [0, count) in parallel chunks on pool threads,
+// then appends chunks to writer in order
+template <typename WriteAt>
+void writeInChunks(Writer& writer, ThreadPool& pool, std::size_t count, WriteAt&& writeAt)
+{
+    pool.encodeChunked<std::string>(count,
+        [&writeAt](std::string& chunk, std::size_t begin, std::size_t end)
+        {
+            Writer chunkWriter(chunk);
+            for (std::size_t i = begin; i != end; ++i) {
+                writeAt(chunkWriter, i);
+            }
+        },
+        [&writer](const std::string& chunk)
+        {
+            writer.writeBytes(chunk.data(), chunk.size());
+        }
+    );
+}
+
+// Writes values through meta::Archive traversal, keys aren't written
+class WriterArchive : public meta::Archive<WriterArchive> {
+public:
+    explicit WriterArchive(Writer& writer) : writer(writer) { }
+
+    std::size_t written() const { return writer.size(); }
+
+    template <typename Class>
+    std::size_t beginObject() { return writer.beginObject(); }
+    template <typename Class>
+    void key(std::size_t, std::size_t) { }
+    template <typename Class>
+    void endObject(std::size_t position) { writer.endObject(position); }
+
+    void beginSequence(std::size_t count) { writer.writeVarint(count); }
+    void element(std::size_t) { }
+    void endSequence() { }
+
+    void beginMap(std::size_t count) { writer.writeVarint(count); }
+    template <typename K>
+    void mapKey(const K& key, std::size_t) { save(key); }
+    void endMap() { }
+
+    template <typename T>
+    void scalar(const T& obj);
+
+    // raw serializable elements are written with memcpy, big containers in parallel chunks
+    template <typename T, typename A>
+    void saveSequence(const std::vector<T, A>& obj);
+
+    template <typename K, typename V, typename H, typename E, typename A>
+    void saveMap(const std::unordered_map<K, V, H, E, A>& obj);
+
+private:
+    Writer& writer;
+};
+
+// out of line members are inline for the same reason as in Archive.inl
+template <typename T>
+inline void WriterArchive::scalar(const T& obj)
+{
+    if constexpr (std::is_same<T, bool>::value) {
+        writer.writeByte(obj ? 1 : 0);
+    } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+        writer.writeZigzag(obj);
+    } else if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+        writer.writeVarint(static_cast<std::uint64_t>(obj));
+    } else if constexpr (std::is_same<T, float>::value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &obj, sizeof(bits));
+        writer.writeFixed32(bits);
+    } else if constexpr (std::is_same<T, double>::value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &obj, sizeof(bits));
+        writer.writeFixed64(bits);
+    } else if constexpr (is_basic_string<T>::value) {
+        writer.writeVarint(obj.size());
+        writer.writeBytes(obj.data(), obj.size());
+    } else {
+        static_assert(dependent_false<T>::value, "Type is not supported by binary serialization");
+    }
+}
+
+template <typename T, typename A>
+inline void WriterArchive::saveSequence(const std::vector<T, A>& obj)
+{
+    if constexpr (is_raw_serializable<T>::value) {
+        beginSequence(obj.size());
+        if (hasNativeRawLayout<T>()) {
+            writer.writeBytes(reinterpret_cast<const char*>(obj.data()), obj.size() * sizeof(T));
+        } else {
+            for (const auto& elem : obj) {
+                writeRaw(writer, elem);
+            }
+        }
+    } else if (ThreadPool* pool = ThreadPool::currentFor(obj.size())) {
+        beginSequence(obj.size());
+        writeInChunks(writer, *pool, obj.size(),
+            [&obj](Writer& chunkWriter, std::size_t i) { WriterArchive(chunkWriter).save(static_cast<const T&>(obj[i])); });
+    } else {
+        meta::Archive<WriterArchive>::saveSequence(obj);
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+inline void WriterArchive::saveMap(const std::unordered_map<K, V, H, E, A>& obj)
+{
+    ThreadPool* pool = ThreadPool::currentFor(obj.size());
+    if (!pool) {
+        meta::Archive<WriterArchive>::saveMap(obj);
+        return;
+    }
+    beginMap(obj.size());
+    std::vector<const std::pair<const K, V>*> entries; // chunks need random access
+    entries.reserve(obj.size());
+    for (const auto& pair : obj) {
+        entries.push_back(&pair);
+    }
+    writeInChunks(writer, *pool, entries.size(),
+        [&entries](Writer& chunkWriter, std::size_t i)
+        {
+            WriterArchive archive(chunkWriter);
+            archive.save(entries[i]->first);
+            archive.save(entries[i]->second);
+        }
+    );
+}
+
+} // end of namespace detail
+
+template <typename T>
+void writeValue(Writer& writer, const T& obj)
+{
+    detail::WriterArchive(writer).save(obj);
+}
+
+/////////////////// DESERIALIZATION
+
+namespace detail
+{
+
+template <typename Class, typename MemberType>
+void readMember(Reader& reader, Class& obj, const MemberType& member, std::size_t index)
+{
+    using MemberT = meta::get_member_type<MemberType>;
+    meta::detail::countMemberWrite<Class>(index, !member.canGetRef());
+    if (member.canGetRef()) { // always true for data members
+        readValue(reader, member.getRef(obj));
+        return;
+    }
+    if constexpr (std::is_default_constructible<MemberT>::value) {
+        MemberT value{};
+        readValue(reader, value);
+        member.set(obj, std::move(value));
+    } else {
+        reader.error("can't deserialize member: it has no non-const getter and its type is not default constructible");
+    }
+}
+
+template <typename T>
+void readRaw(Reader& reader, T& obj)
+{
+    if constexpr (meta::isRegistered<T>()) {
+        meta::doForAllMembers<T>(
+            [&reader, &obj](const auto& member)
+            {
+                readRaw(reader, member.getRef(obj));
+            }
+        );
+    } else {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, reader.readBytes(sizeof(T)), sizeof(T));
+        if (!isLittleEndianHost()) {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        std::memcpy(&obj, bytes, sizeof(T));
+    }
+}
+
+// true if new elements of T can't be default constructed and decoded in place
+template <typename T>
+constexpr bool isConstructedFromData()
+{
+    return meta::ctorRegistered<T>() && !std::is_default_constructible<T>::value;
+}
+
+// builds T with meta::constructFrom from the next object. Object is decoded by a reader of its own,
+// so nesting of such objects is limited here
+template <typename T>
+T constructElement(Reader& reader)
+{
+    static thread_local unsigned depth = 0;
+    if (depth == Reader::maxDepth) {
+        reader.error("too deeply nested");
+    }
+    struct Nested {
+        Nested() { ++depth; }
+        ~Nested() { --depth; }
+    } nested;
+    const char* begin = reader.position();
+    reader.endObject(reader.beginObject());
+    return meta::constructFrom<T, LazyFormat>(std::string_view(begin, reader.position() - begin));
+}
+
+} // end of namespace detail
+
+template <typename T>
+void readValue(Reader& reader, T& obj)
+{
+    if constexpr (meta::isRegistered<T>()) {
+        const auto stats = meta::detail::countScope<T>(meta::detail::StatsOp::Deserialize,
+            [&reader]() { return reader.offset(); });
+        const char* objectEnd = reader.beginObject();
+        std::size_t index = 0;
+        meta::doForAllMembersUntil<T>(
+            [&reader, &obj, objectEnd, &index](const auto& member)
+            {
+                if (reader.atEnd(objectEnd)) {
+                    return true; // object was written by older version of the class
+                }
+                detail::readMember(reader, obj, member, index++);
+                return false;
+            }
+        );
+        reader.endObject(objectEnd);
+    } else if constexpr (std::is_same<T, bool>::value) {
+        obj = reader.readByte() != 0;
+    } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+        obj = static_cast<T>(reader.readZigzag());
+    } else if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+        obj = static_cast<T>(reader.readVarint());
+    } else if constexpr (std::is_same<T, float>::value) {
+        const std::uint32_t bits = reader.readFixed32();
+        std::memcpy(&obj, &bits, sizeof(bits));
+    } else if constexpr (std::is_same<T, double>::value) {
+        const std::uint64_t bits = reader.readFixed64();
+        std::memcpy(&obj, &bits, sizeof(bits));
+    } else if constexpr (is_basic_string<T>::value) {
+        const std::size_t size = reader.readCount();
+        obj.assign(reader.readBytes(size), size); // keeps capacity
+    } else {
+        static_assert(detail::dependent_false<T>::value, "Type is not supported by binary serialization");
+    }
+}
+
+template <typename T, typename A>
+void readValue(Reader& reader, std::vector<T, A>& obj)
+{
+    const std::size_t count = reader.readCount();
+    if constexpr (detail::isConstructedFromData<T>()) {
+        if (count < obj.size()) {
+            obj.erase(obj.begin() + count, obj.end());
+        }
+        for (auto& elem : obj) {
+            readValue(reader, elem); // existing elements are reused
+        }
+        obj.reserve(count);
+        while (obj.size() < count) {
+            obj.push_back(detail::constructElement<T>(reader));
+        }
+    } else if constexpr (detail::is_raw_serializable<T>::value) {
+        if (detail::hasNativeRawLayout<T>()) {
+            const char* data = reader.readBytes(count * sizeof(T)); // checks size before resizing
+            obj.resize(count);
+            if (count != 0) {
+                std::memcpy(obj.data(), data, count * sizeof(T));
+            }
+            return;
+        }
+        obj.resize(count);
+        for (auto& elem : obj) {
+            detail::readRaw(reader, elem);
+        }
+    } else {
+        obj.resize(count); // existing elements are reused
+        for (auto& elem : obj) {
+            readValue(reader, elem);
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void readValue(Reader& reader, std::unordered_map<K, V, H, E, A>& obj)
+{
+    // keys of entries which were in map before decoding are remembered to erase ones not present in data
+    const bool hadEntries = !obj.empty();
+    std::vector<const K*> seenKeys;
+    seenKeys.reserve(obj.size()); // usually the same keys are decoded again
+    const std::size_t count = reader.readCount();
+    auto key = makeWithAllocator<K>(obj.get_allocator());
+    for (std::size_t i = 0; i < count; ++i) {
+        readValue(reader, key); // keeps capacity for string keys
+        typename std::unordered_map<K, V, H, E, A>::iterator it;
+        bool decoded = false;
+        if constexpr (detail::isConstructedFromData<V>()) {
+            it = obj.find(key);
+            if (it == obj.end()) {
+                it = obj.emplace(key, detail::constructElement<V>(reader)).first;
+                decoded = true;
+            }
+        } else {
+            it = obj.try_emplace(key).first;
+        }
+        if (hadEntries) {
+            seenKeys.push_back(&it->first);
+        }
+        if (!decoded) {
+            readValue(reader, it->second);
+        }
+    }
+    if (!hadEntries) {
+        return;
+    }
+    std::sort(seenKeys.begin(), seenKeys.end(), std::less<const K*>());
+    seenKeys.erase(std::unique(seenKeys.begin(), seenKeys.end()), seenKeys.end());
+    if (obj.size() == seenKeys.size()) {
+        return;
+    }
+    for (auto it = obj.begin(); it != obj.end();) {
+        const bool seen = std::binary_search(seenKeys.begin(), seenKeys.end(), &it->first, std::less<const K*>());
+        it = seen ? std::next(it) : obj.erase(it);
+    }
+}
+
+/////////////////// SKIPPING
+
+namespace detail
+{
+
+template <typename T>
+struct value_skipper {
+    static void skip(Reader& reader)
+    {
+        if constexpr (meta::isRegistered<T>()) {
+            reader.endObject(reader.beginObject());
+        } else if constexpr (std::is_same<T, bool>::value) {
+            reader.readByte();
+        } else if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+            reader.readVarint();
+        } else if constexpr (std::is_same<T, float>::value) {
+            reader.readFixed32();
+        } else if constexpr (std::is_same<T, double>::value) {
+            reader.readFixed64();
+        } else if constexpr (is_basic_string<T>::value) {
+            reader.readBytes(reader.readCount());
+        } else {
+            static_assert(dependent_false<T>::value, "Type is not supported by binary serialization");
+        }
+    }
+};
+
+template <typename T, typename A>
+struct value_skipper<std::vector<T, A>> {
+    static void skip(Reader& reader)
+    {
+        const std::size_t count = reader.readCount();
+        if constexpr (is_raw_serializable<T>::value) {
+            reader.readBytes(count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; ++i) {
+                value_skipper<T>::skip(reader);
+            }
+        }
+    }
+};
+
+template <typename K, typename V, typename H, typename E, typename A>
+struct value_skipper<std::unordered_map<K, V, H, E, A>> {
+    static void skip(Reader& reader)
+    {
+        const std::size_t count = reader.readCount();
+        for (std::size_t i = 0; i < count; ++i) {
+            value_skipper<K>::skip(reader);
+            value_skipper<V>::skip(reader);
+        }
+    }
+};
+
+} // end of namespace detail
+
+template <typename T>
+void skipValue(Reader& reader)
+{
+    detail::value_skipper<T>::skip(reader);
+}
+
+/////////////////// LAZY VIEWS
+
+template <typename Class, std::size_t N>
+void LazyFormat::findMembers(std::string_view data, std::array<std::string_view, N>& spans)
+{
+    Reader reader(data.data(), data.data() + data.size());
+    const char* objectEnd = reader.beginObject();
+    std::size_t index = 0;
+    meta::doForAllMembersUntil<Class>(
+        [&reader, &spans, &index, &data, objectEnd](const auto& member)
+        {
+            if (reader.atEnd(objectEnd)) {
+                return true;
+            }
+            const std::size_t begin = reader.offset();
+            skipValue<meta::get_member_type<decltype(member)>>(reader);
+            spans[index++] = data.substr(begin, reader.offset() - begin);
+            return false;
+        }
+    );
+    reader.endObject(objectEnd);
+    reader.finish();
+}
+
+template <typename T>
+void LazyFormat::decode(std::string_view encoded, T& value)
+{
+    Reader reader(encoded.data(), encoded.data() + encoded.size());
+    readValue(reader, value);
+    reader.finish();
+}
+
+}
@@ -0,0 +1,62 @@
+// Delta serialization: patch which turns one instance of a type into another.
+//
+// Patch holds only what changed, so its size and encoding cost depend on amount of change:
+// - registered class: (member index + 1, patch of member) for each changed member, then 0
+// - std::vector: new size, (element index + 1, patch of element) for each changed element, then 0.
+//   Elements past the old size are written as whole values (see BinaryCast.h)
+// - std::unordered_map: number of removed keys and the keys, then (1, key, patch or whole value)
+//   for each changed or added entry, then 0
+// - other values (numbers, strings) are written as whole values if they differ
+//
+// Patch should be applied to an object equal to the base it was made from.
+// Members are written with Member::set when they can't be accessed by reference.
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <Meta.h>
+#include "BinaryCast.h"
+
+namespace Binary
+{
+
+// Appends patch from base to current to out. Returns false and writes nothing if they're equal
+template <typename T>
+bool writePatch(std::string& out, const T& base, const T& current);
+
+// Returns empty string if base and current are equal
+template <typename T>
+std::string makePatch(const T& base, const T& current);
+
+// Does nothing for an empty patch
+template <typename T>
+void applyPatch(T& obj, std::string_view patch);
+
+/////////////////// VALUES
+
+// these return true if anything has changed. If nothing has, what they wrote should be dropped
+template <typename T>
+bool writeDiff(Writer& writer, const T& base, const T& current);
+
+template <typename T, typename A>
+bool writeDiff(Writer& writer, const std::vector<T, A>& base, const std::vector<T, A>& current);
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool writeDiff(Writer& writer, const std::unordered_map<K, V, H, E, A>& base,
+    const std::unordered_map<K, V, H, E, A>& current);
+
+template <typename T>
+void applyDiff(Reader& reader, T& obj);
+
+template <typename T, typename A>
+void applyDiff(Reader& reader, std::vector<T, A>& obj);
+
+template <typename K, typename V, typename H, typename E, typename A>
+void applyDiff(Reader& reader, std::unordered_map<K, V, H, E, A>& obj);
+
+}
+
+#include "BinaryPatch.inl"
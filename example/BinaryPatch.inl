@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace Binary
+{
+
+/////////////////// ENTRY POINTS
+
+template <typename T>
+bool writePatch(std::string& out, const T& base, const T& current)
+{
+    Writer writer(out);
+    const std::size_t start = writer.size();
+    if (!writeDiff(writer, base, current)) {
+        writer.truncate(start);
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+std::string makePatch(const T& base, const T& current)
+{
+    std::string out;
+    writePatch(out, base, current);
+    return out;
+}
+
+template <typename T>
+void applyPatch(T& obj, std::string_view patch)
+{
+    if (patch.empty()) {
+        return;
+    }
+    Reader reader(patch.data(), patch.data() + patch.size());
+    applyDiff(reader, obj);
+    reader.finish();
+}
+
+/////////////////// DIFF
+
+namespace detail
+{
+
+template <typename T>
+bool valuesEqual(const T& a, const T& b)
+{
+    if constexpr (std::is_floating_point<T>::value) {
+        return std::memcmp(&a, &b, sizeof(T)) == 0; // NaN doesn't produce patch every time
+    } else {
+        return a == b;
+    }
+}
+
+// diff of an element which can be dropped: writes tag, then diff, drops both if nothing changed
+template <typename T>
+bool writeTaggedDiff(Writer& writer, std::uint64_t tag, const T& base, const T& current)
+{
+    const std::size_t start = writer.size();
+    writer.writeVarint(tag);
+    if (!writeDiff(writer, base, current)) {
+        writer.truncate(start);
+        return false;
+    }
+    return true;
+}
+
+} // end of namespace detail
+
+template <typename T>
+bool writeDiff(Writer& writer, const T& base, const T& current)
+{
+    if constexpr (meta::isRegistered<T>()) {
+        bool changed = false;
+        std::uint64_t index = 0;
+        meta::doForAllMembers<T>(
+            [&writer, &base, &current, &changed, &index](const auto& member)
+            {
+                using MemberInfo = std::decay_t<decltype(member)>;
+                ++index; // 0 terminates the list, so tags are index + 1
+                if constexpr (MemberInfo::canGetConstRef()) {
+                    changed |= detail::writeTaggedDiff(writer, index, member.get(base), member.get(current));
+                } else {
+                    changed |= detail::writeTaggedDiff(writer, index, member.getCopy(base), member.getCopy(current));
+                }
+            }
+        );
+        writer.writeVarint(0);
+        return changed;
+    } else {
+        if (detail::valuesEqual(base, current)) {
+            return false;
+        }
+        writeValue(writer, current);
+        return true;
+    }
+}
+
+template <typename T, typename A>
+bool writeDiff(Writer& writer, const std::vector<T, A>& base, const std::vector<T, A>& current)
+{
+    bool changed = base.size() != current.size();
+    writer.writeVarint(current.size());
+    const std::size_t common = std::min(base.size(), current.size());
+    for (std::size_t i = 0; i < common; ++i) {
+        changed |= detail::writeTaggedDiff(writer, i + 1, base[i], current[i]);
+    }
+    for (std::size_t i = common; i < current.size(); ++i) {
+        writer.writeVarint(i + 1);
+        writeValue(writer, current[i]);
+    }
+    writer.writeVarint(0);
+    return changed;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool writeDiff(Writer& writer, const std::unordered_map<K, V, H, E, A>& base,
+    const std::unordered_map<K, V, H, E, A>& current)
+{
+    std::size_t removed = 0;
+    for (const auto& pair : base) {
+        removed += current.count(pair.first) == 0 ? 1 : 0;
+    }
+    writer.writeVarint(removed);
+    if (removed != 0) {
+        for (const auto& pair : base) {
+            if (current.count(pair.first) == 0) {
+                writeValue(writer, pair.first);
+            }
+        }
+    }
+
+    bool changed = removed != 0;
+    for (const auto& pair : current) {
+        const auto it = base.find(pair.first);
+        if (it == base.end()) {
+            writer.writeByte(1);
+            writeValue(writer, pair.first);
+            writeValue(writer, pair.second);
+            changed = true;
+            continue;
+        }
+        const std::size_t start = writer.size();
+        writer.writeByte(1);
+        writeValue(writer, pair.first);
+        if (writeDiff(writer, it->second, pair.second)) {
+            changed = true;
+        } else {
+            writer.truncate(start);
+        }
+    }
+    writer.writeByte(0);
+    return changed;
+}
+
+/////////////////// APPLY
+
+namespace detail
+{
+
+template <typename Class, typename MemberType>
+void applyMemberDiff(Reader& reader, Class& obj, const MemberType& member)
+{
+    if (member.canGetRef()) { // always true for data members
+        applyDiff(reader, member.getRef(obj));
+        return;
+    }
+    auto value = member.getCopy(obj);
+    applyDiff(reader, value);
+    member.set(obj, std::move(value));
+}
+
+} // end of namespace detail
+
+template <typename T>
+void applyDiff(Reader& reader, T& obj)
+{
+    if constexpr (meta::isRegistered<T>()) {
+        for (std::uint64_t tag = reader.readVarint(); tag != 0; tag = reader.readVarint()) {
+            if (tag > meta::getMemberCount<T>()) {
+                reader.error("bad member index in patch");
+            }
+            meta::detail::for_tuple_at(static_cast<std::size_t>(tag - 1),
+                [&reader, &obj](const auto& member)
+                {
+                    detail::applyMemberDiff(reader, obj, member);
+                },
+                meta::getMembers<T>()
+            );
+        }
+    } else {
+        readValue(reader, obj);
+    }
+}
+
+template <typename T, typename A>
+void applyDiff(Reader& reader, std::vector<T, A>& obj)
+{
+    const std::size_t oldSize = obj.size();
+    const std::uint64_t size = reader.readVarint();
+    // unchanged elements take no space in patch, added ones take at least a byte each
+    if (size > oldSize && size - oldSize > reader.remaining()) {
+        reader.error("vector size is bigger than patch allows");
+    }
+    obj.resize(static_cast<std::size_t>(size));
+    for (std::uint64_t tag = reader.readVarint(); tag != 0; tag = reader.readVarint()) {
+        if (tag > size) {
+            reader.error("bad element index in patch");
+        }
+        const std::size_t i = static_cast<std::size_t>(tag - 1);
+        if (i < oldSize) {
+            applyDiff(reader, obj[i]);
+        } else {
+            readValue(reader, obj[i]);
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void applyDiff(Reader& reader, std::unordered_map<K, V, H, E, A>& obj)
+{
+    auto key = makeWithAllocator<K>(obj.get_allocator());
+    for (std::size_t removed = reader.readCount(); removed != 0; --removed) {
+        readValue(reader, key);
+        obj.erase(key);
+    }
+    while (reader.readByte() != 0) {
+        readValue(reader, key);
+        const auto inserted = obj.try_emplace(key);
+        if (inserted.second) {
+            readValue(reader, inserted.first->second);
+        } else {
+            applyDiff(reader, inserted.first->second);
+        }
+    }
+}
+
+}
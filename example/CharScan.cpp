@@ -0,0 +1,206 @@
+#include "CharScan.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#define CHARSCAN_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CHARSCAN_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef CHARSCAN_AVX2
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#define CHARSCAN_NEON
+#include <arm_neon.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace CharScan
+{
+
+namespace
+{
+
+// masks are not 0
+int countTrailingZeros(std::uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+#ifdef CHARSCAN_NEON
+int countTrailingZeros(std::uint64_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+#endif
+
+template <bool Control>
+bool isSpecial(char c)
+{
+    return c == '"' || c == '\\' || (Control && static_cast<unsigned char>(c) < 0x20);
+}
+
+template <bool Control>
+const char* findScalar(const char* begin, const char* end)
+{
+    while (begin != end && !isSpecial<Control>(*begin)) {
+        ++begin;
+    }
+    return begin;
+}
+
+// Each block type has the same interface: Chars is a vector register of Block::size chars,
+// comparisons produce all ones in matching chars, firstMatch returns index of the first one or -1
+
+#ifdef CHARSCAN_AVX2
+struct Avx2Block {
+    using Chars = __m256i;
+    static constexpr std::ptrdiff_t size = 32;
+
+    static Chars load(const char* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+    static Chars splat(char c) { return _mm256_set1_epi8(c); }
+    static Chars equal(Chars a, Chars b) { return _mm256_cmpeq_epi8(a, b); }
+    static Chars either(Chars a, Chars b) { return _mm256_or_si256(a, b); }
+    // unsigned a <= b, there's no unsigned comparison in AVX2
+    static Chars atMost(Chars a, Chars b) { return _mm256_cmpeq_epi8(_mm256_min_epu8(a, b), a); }
+
+    static int firstMatch(Chars found)
+    {
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(found));
+        return mask != 0 ? countTrailingZeros(mask) : -1;
+    }
+};
+#endif
+
+#ifdef CHARSCAN_SSE2
+struct Sse2Block {
+    using Chars = __m128i;
+    static constexpr std::ptrdiff_t size = 16;
+
+    static Chars load(const char* ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+    static Chars splat(char c) { return _mm_set1_epi8(c); }
+    static Chars equal(Chars a, Chars b) { return _mm_cmpeq_epi8(a, b); }
+    static Chars either(Chars a, Chars b) { return _mm_or_si128(a, b); }
+    static Chars atMost(Chars a, Chars b) { return _mm_cmpeq_epi8(_mm_min_epu8(a, b), a); }
+
+    static int firstMatch(Chars found)
+    {
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(found));
+        return mask != 0 ? countTrailingZeros(mask) : -1;
+    }
+};
+#endif
+
+#ifdef CHARSCAN_NEON
+struct NeonBlock {
+    using Chars = uint8x16_t;
+    static constexpr std::ptrdiff_t size = 16;
+
+    static Chars load(const char* ptr) { return vld1q_u8(reinterpret_cast<const std::uint8_t*>(ptr)); }
+    static Chars splat(char c) { return vdupq_n_u8(static_cast<std::uint8_t>(c)); }
+    static Chars equal(Chars a, Chars b) { return vceqq_u8(a, b); }
+    static Chars either(Chars a, Chars b) { return vorrq_u8(a, b); }
+    static Chars atMost(Chars a, Chars b) { return vcleq_u8(a, b); }
+
+    static int firstMatch(Chars found)
+    {
+        // there's no movemask in NEON: narrowing shift leaves 4 bits per char in 64 bit value
+        const std::uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(found), 4)), 0);
+        return mask != 0 ? countTrailingZeros(mask) / 4 : -1;
+    }
+};
+#endif
+
+// checks whole blocks with the first block type, then passes the rest to the next (smaller) one
+template <bool Control, typename Block, typename... Smaller>
+const char* findInBlocks(const char* begin, const char* end)
+{
+    const auto quote = Block::splat('"');
+    const auto backslash = Block::splat('\\');
+    const auto lastControl = Block::splat(0x1F);
+    for (; end - begin >= Block::size; begin += Block::size) {
+        const auto chars = Block::load(begin);
+        auto found = Block::either(Block::equal(chars, quote), Block::equal(chars, backslash));
+        if constexpr (Control) {
+            found = Block::either(found, Block::atMost(chars, lastControl));
+        }
+        const int index = Block::firstMatch(found);
+        if (index >= 0) {
+            return begin + index;
+        }
+    }
+    if constexpr (sizeof...(Smaller) != 0) {
+        return findInBlocks<Control, Smaller...>(begin, end);
+    } else {
+        return findScalar<Control>(begin, end);
+    }
+}
+
+template <bool Control>
+const char* find(const char* begin, const char* end)
+{
+#if defined(CHARSCAN_AVX2)
+    return findInBlocks<Control, Avx2Block, Sse2Block>(begin, end);
+#elif defined(CHARSCAN_SSE2)
+    return findInBlocks<Control, Sse2Block>(begin, end);
+#elif defined(CHARSCAN_NEON)
+    return findInBlocks<Control, NeonBlock>(begin, end);
+#else
+    return findScalar<Control>(begin, end);
+#endif
+}
+
+} // end of anonymous namespace
+
+const char* findEscaped(const char* begin, const char* end)
+{
+    return find<true>(begin, end);
+}
+
+const char* findQuoteOrEscape(const char* begin, const char* end)
+{
+    return find<false>(begin, end);
+}
+
+const char* findEscapedScalar(const char* begin, const char* end)
+{
+    return findScalar<true>(begin, end);
+}
+
+const char* findQuoteOrEscapeScalar(const char* begin, const char* end)
+{
+    return findScalar<false>(begin, end);
+}
+
+const char* instructionSet()
+{
+#if defined(CHARSCAN_AVX2)
+    return "avx2";
+#elif defined(CHARSCAN_SSE2)
+    return "sse2";
+#elif defined(CHARSCAN_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+}
@@ -0,0 +1,25 @@
+// Kernels which find chars the JSON writer and reader stop at inside of strings.
+//
+// They check 32 (AVX2) or 16 (SSE2, NEON) bytes at a time, instruction set is chosen at compile
+// time from target flags (SSE2 is always available on x86-64, build with -mavx2 or -march=native
+// for AVX2). The rest of the string and strings shorter than one block are checked by scalar loop,
+// which is also used on other targets. Blocks are only loaded from inside of [begin, end).
+#pragma once
+
+namespace CharScan
+{
+
+// returns pointer to first '"', '\\' or control char (< 0x20) in [begin, end) or end
+const char* findEscaped(const char* begin, const char* end);
+
+// returns pointer to first '"' or '\\' in [begin, end) or end
+const char* findQuoteOrEscape(const char* begin, const char* end);
+
+// the same, one char at a time
+const char* findEscapedScalar(const char* begin, const char* end);
+const char* findQuoteOrEscapeScalar(const char* begin, const char* end);
+
+// name of instruction set used by findEscaped and findQuoteOrEscape: "avx2", "sse2", "neon" or "scalar"
+const char* instructionSet();
+
+}
@@ -4,6 +4,12 @@
 namespace Json
 {
 
+template <>
+bool deserialize_basic(const Value& obj)
+{
+    return obj.asBool();
+}
+
 template <>
 int deserialize_basic(const Value& obj)
 {
@@ -22,4 +28,4 @@ std::string deserialize_basic(const Value& obj)
     return obj.asString();
 }
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -7,8 +7,13 @@
 
 #include <json/json-forwards.h>
 
+#include <Archive.h>
 #include <Meta.h>
+#include <Projection.h>
+#include <SoaVector.h>
+#include "MemoryResource.h"
 #include "StringCast.h"
+#include "ThreadPool.h"
 
 namespace Json
 {
@@ -19,36 +24,38 @@ template <typename Class,
     typename = std::enable_if_t<std::is_constructible<Value, Class>::value>>
 Value serialize(const Class& obj);
 
+// Registered classes, std::vector and std::unordered_map are serialized through meta::Archive
+// (see detail::ValueArchive), other values which Value can't be constructed from with serialize_basic.
+// Big containers are serialized in parallel when ThreadPool::Scope is active, see ThreadPool.h
 template <typename Class,
     typename = std::enable_if_t<!std::is_constructible<Value, Class>::value>,
     typename = void>
 Value serialize(const Class& obj);
 
-template <typename Class,
-    typename = std::enable_if_t <meta::isRegistered<Class>()>>
-Value serialize_impl(const Class& obj);
-
-template <typename Class,
-    typename = std::enable_if_t <!meta::isRegistered<Class>()>,
-    typename = void>
-Value serialize_impl(const Class& obj);
-
+// returns null, overload it for your types
 template <typename Class>
 Value serialize_basic(const Class& obj);
-// specialization for std::vector
-template <typename T>
-Value serialize_basic(const std::vector<T>& obj);
+// strings with custom allocators, std::string is handled by Value constructor
+template <typename Traits, typename Alloc>
+Value serialize_basic(const std::basic_string<char, Traits, Alloc>& obj);
 
-// specialization for std::unodered_map
-template <typename K, typename V>
-Value serialize_basic(const std::unordered_map<K, V>& obj);
+// only members selected by projection are serialized, see Projection.h
+template <typename Class>
+Value serialize(const Class& obj, const meta::Projection<Class>& projection);
 
 
 /////////////////// DESERIALIZATION
 
+// Classes with registered constructor (see meta::constructor_args) are constructed from
+// values of their members, others are default constructed and then deserialized
 template<typename Class>
 Class deserialize(const Value& obj);
 
+// Class is constructed with resource (see MemoryResource.h) and deserialized in place,
+// so its allocator aware members allocate from resource
+template<typename Class>
+Class deserialize(const Value& obj, std::pmr::memory_resource* resource);
+
 template <typename Class,
     typename = std::enable_if_t<meta::isRegistered<Class>()>>
 void deserialize(Class& obj, const Value& object);
@@ -62,18 +69,69 @@ template <typename T>
 T deserialize_basic(const Value& obj);
 
 // specializations
+template <> bool deserialize_basic(const Value& obj);
 template <> int deserialize_basic(const Value& obj);
 template <> float deserialize_basic(const Value& obj);
 template <> std::string deserialize_basic(const Value& obj);
 
-// specialization for std::vector
-template <typename T>
-void deserialize(std::vector<T>& obj, const Value& object);
+template <typename Traits, typename Alloc>
+void deserialize(std::basic_string<char, Traits, Alloc>& obj, const Value& object);
+
+// specialization for std::vector, elements are appended
+template <typename T, typename A>
+void deserialize(std::vector<T, A>& obj, const Value& object);
 
 // specialization for std::unodered_map
-template <typename K, typename V>
-void deserialize(std::unordered_map<K, V>& obj, const Value& object);
+template <typename K, typename V, typename H, typename E, typename A>
+void deserialize(std::unordered_map<K, V, H, E, A>& obj, const Value& object);
+
+/////////////////// IN PLACE DESERIALIZATION
+
+// deserialize(obj, value, Json::inPlace) overwrites existing object instead of building new values:
+// members are deserialized through references when they're accessible (data members, non-const getters),
+// setters are used otherwise. Strings and containers keep storage they already have, so decoding
+// repeatedly into a long-lived object of the same shape doesn't allocate.
+struct in_place_t { };
+constexpr in_place_t inPlace{};
+
+template <typename Class,
+    typename = std::enable_if_t<meta::isRegistered<Class>()>>
+void deserialize(Class& obj, const Value& object, in_place_t);
+
+template <typename Class,
+    typename = std::enable_if_t<!meta::isRegistered<Class>()>,
+    typename = void>
+void deserialize(Class& obj, const Value& object, in_place_t);
+
+template <typename Traits, typename Alloc>
+void deserialize(std::basic_string<char, Traits, Alloc>& obj, const Value& object, in_place_t);
+
+// elements are reused, vector is resized to the size of array
+template <typename T, typename A>
+void deserialize(std::vector<T, A>& obj, const Value& object, in_place_t);
+
+// values of existing keys are reused, keys which are not in object are erased
+template <typename K, typename V, typename H, typename E, typename A>
+void deserialize(std::unordered_map<K, V, H, E, A>& obj, const Value& object, in_place_t);
+
+/////////////////// BATCH DESERIALIZATION
+
+// Decodes array of objects of registered Class into pre-sized storage: out is resized to the size
+// of array and rows are decoded in place, like with Json::inPlace, so no temporary objects are
+// built and moved. Big arrays are decoded in parallel when ThreadPool::Scope is active, see
+// ThreadPool.h: setters of members can be called from pool threads, for different objects.
+// Plain deserialize(vector, array) never does that, it decodes elements one by one
+template <typename Class, typename A>
+void deserializeBatch(std::vector<Class, A>& out, const Value& array);
+
+// the same, but members are decoded straight into columns of soa_vector, see SoaVector.h
+template <typename Class>
+void deserializeBatch(meta::soa_vector<Class>& out, const Value& array);
+
+// in place deserialization of members selected by projection, other members are left untouched
+template <typename Class>
+void deserialize(Class& obj, const Value& object, const meta::Projection<Class>& projection);
 
 }
 
-#include "JsonCast.inl"
\ No newline at end of file
+#include "JsonCast.inl"
\ No newline at end of file
@@ -1,9 +1,12 @@
+#include <algorithm>
+#include <functional>
+
 #include <json/json.h>
 
 namespace Json
 {
 
-/////////////////// DESERIALIZATION
+/////////////////// SERIALIZATION
 
 template <typename Class,
     typename>
@@ -12,79 +15,360 @@ Value serialize(const Class& obj)
     return Value(obj);
 }
 
-template <typename Class,
-    typename, typename>
-    Value serialize(const Class& obj)
+template <typename Class>
+Value serialize_basic(const Class& obj)
 {
-    return serialize_impl(obj);
+    return Value(nullValue);
 }
 
-template <typename Class,
-    typename>
-Value serialize_impl(const Class& obj)
+template <typename Traits, typename Alloc>
+Value serialize_basic(const std::basic_string<char, Traits, Alloc>& obj)
 {
-    Value value(objectValue);
-    meta::doForAllMembers<Class>(
-        [&obj, &value](auto& member)
+    return Value(obj.data(), obj.data() + obj.size());
+}
+
+namespace detail
+{
+
+template <typename K>
+Value& memberForKey(Value& object, const K& key)
+{
+    if constexpr (std::is_same<K, std::string>::value) {
+        return object[key];
+    } else if constexpr (is_basic_string<K>::value) {
+        return object[std::string(key.data(), key.size())];
+    } else {
+        char str[maxCastLength + 1];
+        *castToChars(str, str + maxCastLength, key) = '\0';
+        return object[str];
+    }
+}
+
+// Calls store(i, serializeAt(i)) for i in [0, count) in order,
+// serializeAt is called in parallel chunks on pool threads
+template <typename SerializeAt, typename Store>
+void serializeInChunks(ThreadPool& pool, std::size_t count, SerializeAt&& serializeAt, Store&& store)
+{
+    std::size_t next = 0;
+    pool.encodeChunked<std::vector<Value>>(count,
+        [&serializeAt](std::vector<Value>& chunk, std::size_t begin, std::size_t end)
+        {
+            chunk.reserve(end - begin);
+            for (std::size_t i = begin; i != end; ++i) {
+                chunk.push_back(serializeAt(i));
+            }
+        },
+        [&store, &next](std::vector<Value>& chunk)
+        {
+            for (auto& elem : chunk) {
+                store(next++, elem);
+            }
+        }
+    );
+}
+
+// Builds Json::Value through meta::Archive traversal: current is the value which is filled next,
+// parents are objects and arrays it is in
+class ValueArchive : public meta::Archive<ValueArchive> {
+public:
+    explicit ValueArchive(Value& root) : current(&root) { }
+
+    // values Value can be constructed from are stored as they are, like Json::serialize does
+    template <typename T>
+    void save(const T& obj)
     {
-        auto& valueName = value[member.getName()];
-        if (member.canGetConstRef()) {
-            valueName = serialize(member.get(obj));
-        } else if (member.hasGetter()) {
-            valueName = serialize(member.getCopy(obj)); // passing copy as const ref, it's okay
+        if constexpr (std::is_constructible<Value, T>::value) {
+            *current = Value(obj);
         } else {
-            throw std::runtime_error("Error: can't deserialize member because it's write only");
+            meta::Archive<ValueArchive>::save(obj);
         }
     }
+
+    std::size_t written() const { return 0; } // size is known only when Value is written
+
+    template <typename Class>
+    std::size_t beginObject()
+    {
+        open(objectValue);
+        return 0;
+    }
+
+    template <typename Class>
+    void key(std::size_t, std::size_t index)
+    {
+        // member names live as long as MetaHolder, so keys point to them instead of being copied
+        current = &(*parents.back())[StaticString(meta::getMemberAccessors<Class>()[index].name)];
+    }
+
+    template <typename Class>
+    void endObject(std::size_t) { close(); }
+
+    void beginSequence(std::size_t count)
+    {
+        open(arrayValue);
+        current->resize(static_cast<ArrayIndex>(count));
+    }
+    void element(std::size_t i) { current = &(*parents.back())[static_cast<ArrayIndex>(i)]; }
+    void endSequence() { close(); }
+
+    void beginMap(std::size_t) { open(objectValue); }
+    template <typename K>
+    void mapKey(const K& key, std::size_t) { current = &memberForKey(*parents.back(), key); }
+    void endMap() { close(); }
+
+    template <typename T>
+    void scalar(const T& obj) { *current = serialize_basic(obj); }
+
+    // big containers are serialized in parallel chunks
+    template <typename T, typename A, typename SaveElement>
+    void saveElements(const std::vector<T, A>& obj, SaveElement&& saveElement);
+
+    template <typename K, typename V, typename H, typename E, typename A, typename SaveElement>
+    void saveEntries(const std::unordered_map<K, V, H, E, A>& obj, SaveElement&& saveElement);
+
+private:
+    void open(ValueType type)
+    {
+        *current = Value(type);
+        parents.push_back(current);
+    }
+
+    void close()
+    {
+        current = parents.back();
+        parents.pop_back();
+    }
+
+    Value* current;
+    std::vector<Value*> parents;
+};
+
+template <typename T, typename A, typename SaveElement>
+void ValueArchive::saveElements(const std::vector<T, A>& obj, SaveElement&& saveElement)
+{
+    ThreadPool* pool = ThreadPool::currentFor(obj.size());
+    if (!pool) {
+        meta::Archive<ValueArchive>::saveElements(obj, saveElement);
+        return;
+    }
+    beginSequence(obj.size());
+    serializeInChunks(*pool, obj.size(),
+        [&obj, &saveElement](std::size_t i)
+        {
+            Value elem;
+            ValueArchive archive(elem);
+            saveElement(archive, static_cast<const T&>(obj[i]));
+            return elem;
+        },
+        [this](std::size_t i, Value& elem) { (*current)[static_cast<ArrayIndex>(i)].swap(elem); }
     );
-    return value;
+    endSequence();
+}
+
+template <typename K, typename V, typename H, typename E, typename A, typename SaveElement>
+void ValueArchive::saveEntries(const std::unordered_map<K, V, H, E, A>& obj, SaveElement&& saveElement)
+{
+    ThreadPool* pool = ThreadPool::currentFor(obj.size());
+    if (!pool) {
+        meta::Archive<ValueArchive>::saveEntries(obj, saveElement);
+        return;
+    }
+    beginMap(obj.size());
+    std::vector<const std::pair<const K, V>*> entries; // chunks need random access
+    entries.reserve(obj.size());
+    for (auto& pair : obj) {
+        entries.push_back(&pair);
+    }
+    serializeInChunks(*pool, entries.size(),
+        [&entries, &saveElement](std::size_t i)
+        {
+            Value elem;
+            ValueArchive archive(elem);
+            saveElement(archive, entries[i]->second);
+            return elem;
+        },
+        [this, &entries](std::size_t i, Value& elem) { memberForKey(*current, entries[i]->first).swap(elem); }
+    );
+    endMap();
 }
 
+} // end of namespace detail
+
 template <typename Class,
     typename, typename>
-Value serialize_impl(const Class& obj)
+Value serialize(const Class& obj)
 {
-    return serialize_basic(obj);
+    Value value;
+    detail::ValueArchive(value).save(obj);
+    return value;
 }
 
+/////////////////// DESERIALIZATION
+
+namespace detail
+{
+
+template <typename Class, typename MemberType>
+void deserializeMemberValue(Class& obj, const MemberType& member, std::size_t index, const Value& value)
+{
+    using MemberT = meta::get_member_type<MemberType>;
+    meta::detail::countMemberWrite<Class>(index, MemberType::hasSetter());
+    if constexpr (MemberType::hasSetter()) {
+        member.set(obj, deserialize<MemberT>(value));
+    } else {
+        deserialize(member.getRef(obj), value); // data member, always can get ref
+    }
+}
+
+template <typename Class, typename MemberType>
+void deserializeMemberInPlace(Class& obj, const MemberType& member, std::size_t index, const Value& value)
+{
+    using MemberT = meta::get_member_type<MemberType>;
+    meta::detail::countMemberWrite<Class>(index, !member.canGetRef());
+    if (member.canGetRef()) { // always true for data members
+        deserialize(member.getRef(obj), value, inPlace);
+    } else {
+        member.set(obj, deserialize<MemberT>(value));
+    }
+}
+
+template <typename Class, typename MemberType>
+void deserializeMember(Class& obj, const Value& object, const MemberType& member, std::size_t index)
+{
+    const auto name = member.getNameView();
+    const Value* objName = object.find(name.data(), name.data() + name.size());
+    if (objName && !objName->isNull()) {
+        deserializeMemberValue(obj, member, index, *objName);
+    }
+}
+
+// Class is built with registered constructor from values of its members (missing ones are
+// default constructed), then other members are deserialized as usual
 template <typename Class>
-Value serialize_basic(const Class& obj)
+Class deserializeConstructed(const Value& object)
 {
-    return Value(nullValue);
+    if (!object.isObject()) {
+        throw std::runtime_error("Error: can't deserialize from Json::Value to Class.");
+    }
+    const auto stats = meta::detail::countScope<Class>(meta::detail::StatsOp::Deserialize);
+    Class obj = meta::constructWith<Class>(
+        [&object](const auto& member)
+        {
+            using MemberT = meta::get_member_type<decltype(member)>;
+            const auto name = member.getNameView();
+            const Value* objName = object.find(name.data(), name.data() + name.size());
+            return objName && !objName->isNull() ? deserialize<MemberT>(*objName) : MemberT();
+        }
+    );
+    std::size_t index = 0;
+    meta::doForAllMembers<Class>(
+        [&obj, &object, &index](const auto& member)
+        {
+            if (!meta::isConstructorArgument<Class>(index)) {
+                deserializeMember(obj, object, member, index);
+            }
+            ++index;
+        }
+    );
+    return obj;
 }
 
-// specialization for std::vector
-template <typename T>
-Value serialize_basic(const std::vector<T>& obj)
+// calls decode(row, member, index, value) for non null values of registered members of object.
+// Members are looked up by name like in deserialize(obj, object): iterating object members of
+// Json::Value is slower than finding them
+template <typename Class, typename Decode>
+void decodeRow(const Value& object, std::size_t row, Decode& decode)
 {
-    Value value(arrayValue);
-    value.resize(obj.size());
-    int i = 0;
-    for (auto& elem : obj) {
-        value[i] = serialize(elem);
-        ++i;
+    if (!object.isObject()) {
+        throw std::runtime_error("Error: can't deserialize from Json::Value to Class.");
     }
-    return value;
+    const auto stats = meta::detail::countScope<Class>(meta::detail::StatsOp::Deserialize);
+    std::size_t index = 0;
+    meta::doForAllMembers<Class>(
+        [&object, row, &decode, &index](const auto& member)
+        {
+            const auto name = member.getNameView();
+            const Value* value = object.find(name.data(), name.data() + name.size());
+            if (value && !value->isNull()) {
+                decode(row, member, index, *value);
+            }
+            ++index;
+        }
+    );
 }
 
-// specialization for std::unodered_map
-template <typename K, typename V>
-Value serialize_basic(const std::unordered_map<K, V>& obj)
+// Decodes each object of array with decodeRow. Rows are split into chunks which are decoded
+// on pool threads when ThreadPool::Scope is active and array is big enough
+template <typename Class, typename Decode>
+void decodeRows(const Value& array, Decode&& decode)
 {
-    Value value(objectValue);
-    for (auto& pair : obj) {
-        value[castToString(pair.first)] = serialize(pair.second);
+    const std::size_t count = array.size();
+    if (count == 0) {
+        return;
     }
-    return value;
+    ThreadPool* pool = ThreadPool::currentFor(count);
+    if (!pool) {
+        std::size_t row = 0;
+        for (auto& object : array) {
+            decodeRow<Class>(object, row++, decode);
+        }
+        return;
+    }
+    std::vector<const Value*> rows; // array elements are not contiguous, so they're collected first
+    rows.reserve(count);
+    for (auto& object : array) {
+        rows.push_back(&object);
+    }
+    const std::size_t chunkCount = std::min<std::size_t>(count, 4 * pool->getThreadCount());
+    const std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    pool->parallelFor(chunkCount,
+        [&rows, &decode, count, chunkSize](std::size_t chunk)
+        {
+            const std::size_t end = std::min(count, (chunk + 1) * chunkSize);
+            for (std::size_t row = std::min(count, chunk * chunkSize); row < end; ++row) {
+                decodeRow<Class>(*rows[row], row, decode);
+            }
+        }
+    );
 }
 
-/////////////////// DESERIALIZATION
+template <typename T>
+void deserializeColumnValue(T& elem, const Value& value)
+{
+    deserialize(elem, value, inPlace);
+}
+
+inline void deserializeColumnValue(meta::soa_bool& elem, const Value& value)
+{
+    deserialize(elem.value, value, inPlace);
+}
+
+template <typename Class, std::size_t... I>
+void deserializeColumn(meta::soa_vector<Class>& out, std::size_t row, std::size_t index, const Value& value,
+    std::index_sequence<I...>)
+{
+    ((I == index ? void(deserializeColumnValue(out.template column<I>()[row], value)) : void()), ...);
+}
+
+} // end of namespace detail
 
 template <typename Class>
 Class deserialize(const Value& obj)
 {
-    Class c;
-    deserialize(c, obj);
+    if constexpr (meta::ctorRegistered<Class>()) {
+        return detail::deserializeConstructed<Class>(obj);
+    } else {
+        Class c;
+        deserialize(c, obj);
+        return c;
+    }
+}
+
+template <typename Class>
+Class deserialize(const Value& obj, std::pmr::memory_resource* resource)
+{
+    Class c = makeWithResource<Class>(resource);
+    deserialize(c, obj, inPlace); // members get values through references, so they keep the resource
     return c;
 }
 
@@ -93,20 +377,12 @@ template <typename Class,
 void deserialize(Class& obj, const Value& object)
 {
     if (object.isObject()) {
+        const auto stats = meta::detail::countScope<Class>(meta::detail::StatsOp::Deserialize);
+        std::size_t index = 0;
         meta::doForAllMembers<Class>(
-            [&obj, &object](auto& member)
+            [&obj, &object, &index](auto& member)
             {
-                auto& objName = object[member.getName()];
-                if (!objName.isNull()) {
-                    using MemberT = meta::get_member_type<decltype(member)>;
-                    if (member.hasSetter()) {
-                        member.set(obj, deserialize<MemberT>(objName));
-                    } else if (member.canGetRef()) {
-                        deserialize(member.getRef(obj), objName);
-                    } else {
-                        throw std::runtime_error("Error: can't deserialize member because it's read only");
-                    }
-                }
+                detail::deserializeMember(obj, object, member, index++);
             }
         );
     } else {
@@ -127,24 +403,285 @@ T deserialize_basic(const Value& obj)
     return T(); // or maybe throw?
 }
 
+template <typename Traits, typename Alloc>
+void deserialize(std::basic_string<char, Traits, Alloc>& obj, const Value& object)
+{
+    deserialize(obj, object, inPlace);
+}
+
 // specialization for std::vector
-template <typename T>
-void deserialize(std::vector<T>& obj, const Value& object)
+template <typename T, typename A>
+void deserialize(std::vector<T, A>& obj, const Value& object)
 {
     obj.reserve(object.size()); // vector.resize() works only for default constructible types
     for (auto& elem : object) {
-        obj.push_back(deserialize<T>(elem)); // push rvalue
+        if constexpr (std::uses_allocator<T, A>::value) {
+            // element is constructed with vector's allocator and filled in place,
+            // temporary would allocate from default resource
+            obj.emplace_back();
+            deserialize(obj.back(), elem);
+        } else {
+            obj.push_back(deserialize<T>(elem)); // push rvalue
+        }
     }
 }
 
 // specialization for std::unodered_map
-template <typename K, typename V>
-void deserialize(std::unordered_map<K, V>& obj, const Value& object)
+template <typename K, typename V, typename H, typename E, typename A>
+void deserialize(std::unordered_map<K, V, H, E, A>& obj, const Value& object)
 {
     // keys in Json are always strings
-    for (auto& keyStr : object.getMemberNames()) {
-        obj.emplace(fromString<K>(keyStr), deserialize<V>(object[keyStr])); // rvalue, oh yeah
+    for (auto it = object.begin(); it != object.end(); ++it) {
+        const char* end = nullptr;
+        const char* begin = it.memberName(&end);
+        auto key = fromString<K>(std::string_view(begin, end - begin), obj.get_allocator());
+        if constexpr (std::uses_allocator<V, A>::value) {
+            const auto inserted = obj.try_emplace(std::move(key)); // value gets map's allocator
+            if (inserted.second) {
+                deserialize(inserted.first->second, *it);
+            }
+        } else {
+            obj.emplace(std::move(key), deserialize<V>(*it)); // rvalue, oh yeah
+        }
+    }
+}
+
+/////////////////// IN PLACE DESERIALIZATION
+
+template <typename Class,
+    typename>
+void deserialize(Class& obj, const Value& object, in_place_t)
+{
+    if (!object.isObject()) {
+        throw std::runtime_error("Error: can't deserialize from Json::Value to Class.");
+    }
+    const auto stats = meta::detail::countScope<Class>(meta::detail::StatsOp::Deserialize);
+    std::size_t index = 0;
+    meta::doForAllMembers<Class>(
+        [&obj, &object, &index](auto& member)
+        {
+            const auto name = member.getNameView();
+            const Value* objName = object.find(name.data(), name.data() + name.size());
+            if (objName && !objName->isNull()) {
+                detail::deserializeMemberInPlace(obj, member, index, *objName);
+            }
+            ++index;
+        }
+    );
+}
+
+template <typename Class,
+    typename, typename>
+void deserialize(Class& obj, const Value& object, in_place_t)
+{
+    obj = deserialize_basic<Class>(object);
+}
+
+template <typename Traits, typename Alloc>
+void deserialize(std::basic_string<char, Traits, Alloc>& obj, const Value& object, in_place_t)
+{
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    if (object.getString(&begin, &end)) {
+        obj.assign(begin, end); // reuses capacity
+    } else {
+        const auto str = object.asString();
+        obj.assign(str.data(), str.size());
+    }
+}
+
+template <typename T, typename A>
+void deserialize(std::vector<T, A>& obj, const Value& object, in_place_t)
+{
+    if constexpr (std::is_default_constructible<T>::value) {
+        obj.resize(object.size());
+        std::size_t i = 0;
+        for (auto& elem : object) {
+            deserialize(obj[i], elem, inPlace);
+            ++i;
+        }
+    } else {
+        obj.clear(); // keeps capacity
+        deserialize(obj, object);
+    }
+}
+
+namespace detail
+{
+
+// entry for key of object member, inserted if it's not in map yet
+template <typename K, typename V, typename H, typename E, typename A>
+typename std::unordered_map<K, V, H, E, A>::value_type& entryForKey(std::unordered_map<K, V, H, E, A>& obj,
+    const ValueConstIterator& it)
+{
+    const char* end = nullptr;
+    const char* begin = it.memberName(&end);
+    if constexpr (std::is_same<K, std::string>::value) {
+        static thread_local std::string key; // keeps its capacity between calls
+        key.assign(begin, end);
+        return *obj.try_emplace(key).first; // key is copied only if it's not in map yet
+    } else {
+        return *obj.try_emplace(fromString<K>(std::string_view(begin, end - begin), obj.get_allocator())).first;
+    }
+}
+
+// calls decodeEntry(value, member) for each member of object and value for its key, then erases
+// entries which weren't decoded. Keys of decoded entries are remembered, like in readEntries of
+// JsonReader, because keys which aren't strings can be spelled differently in JSON ("01", "1.0")
+template <typename K, typename V, typename H, typename E, typename A, typename DecodeEntry>
+void decodeEntries(std::unordered_map<K, V, H, E, A>& obj, const Value& object, DecodeEntry&& decodeEntry)
+{
+    const bool hadEntries = !obj.empty(); // only entries which were in map before can be missing
+    std::vector<const K*> seenKeys;
+    seenKeys.reserve(obj.size()); // usually the same keys are decoded again
+    for (auto it = object.begin(); it != object.end(); ++it) {
+        auto& entry = entryForKey(obj, it);
+        if (hadEntries) {
+            seenKeys.push_back(&entry.first);
+        }
+        decodeEntry(entry.second, *it);
+    }
+    if (!hadEntries) {
+        return;
+    }
+    std::sort(seenKeys.begin(), seenKeys.end(), std::less<const K*>());
+    seenKeys.erase(std::unique(seenKeys.begin(), seenKeys.end()), seenKeys.end()); // "1" and "01" are one key
+    if (obj.size() == seenKeys.size()) {
+        return;
+    }
+    for (auto it = obj.begin(); it != obj.end();) {
+        const bool seen = std::binary_search(seenKeys.begin(), seenKeys.end(), &it->first, std::less<const K*>());
+        it = seen ? std::next(it) : obj.erase(it);
+    }
+}
+
+} // end of namespace detail
+
+template <typename K, typename V, typename H, typename E, typename A>
+void deserialize(std::unordered_map<K, V, H, E, A>& obj, const Value& object, in_place_t)
+{
+    detail::decodeEntries(obj, object,
+        [](V& value, const Value& member) { deserialize(value, member, inPlace); });
+}
+
+/////////////////// BATCH DESERIALIZATION
+
+template <typename Class, typename A>
+void deserializeBatch(std::vector<Class, A>& out, const Value& array)
+{
+    out.resize(array.size());
+    detail::decodeRows<Class>(array,
+        [&out](std::size_t row, const auto& member, std::size_t index, const Value& value)
+        {
+            detail::deserializeMemberInPlace(out[row], member, index, value);
+        }
+    );
+}
+
+template <typename Class>
+void deserializeBatch(meta::soa_vector<Class>& out, const Value& array)
+{
+    out.resize(array.size());
+    detail::decodeRows<Class>(array,
+        [&out](std::size_t row, const auto&, std::size_t index, const Value& value)
+        {
+            detail::deserializeColumn(out, row, index, value, std::make_index_sequence<meta::getMemberCount<Class>()>());
+        }
+    );
+}
+
+/////////////////// PROJECTIONS
+
+namespace detail
+{
+
+// nested projection is applied to registered classes, possibly inside of containers,
+// values are processed whole when there's no projection
+template <typename T, typename C>
+void deserializeProjected(T& obj, const Value& object, const meta::Projection<C>* projection);
+
+template <typename T, typename A, typename C>
+void deserializeProjected(std::vector<T, A>& obj, const Value& object, const meta::Projection<C>* projection);
+
+template <typename K, typename V, typename H, typename E, typename A, typename C>
+void deserializeProjected(std::unordered_map<K, V, H, E, A>& obj, const Value& object, const meta::Projection<C>* projection);
+
+template <typename T, typename C>
+void deserializeProjected(T& obj, const Value& object, const meta::Projection<C>* projection)
+{
+    if constexpr (meta::isRegistered<T>()) {
+        if (projection) {
+            deserialize(obj, object, *projection);
+            return;
+        }
+    }
+    deserialize(obj, object, inPlace);
+}
+
+template <typename T, typename A, typename C>
+void deserializeProjected(std::vector<T, A>& obj, const Value& object, const meta::Projection<C>* projection)
+{
+    if constexpr (std::is_default_constructible<T>::value) {
+        if (projection) {
+            obj.resize(object.size()); // new elements get only selected members
+            std::size_t i = 0;
+            for (auto& elem : object) {
+                deserializeProjected(obj[i], elem, projection);
+                ++i;
+            }
+            return;
+        }
     }
+    deserialize(obj, object, inPlace);
 }
 
-}
\ No newline at end of file
+template <typename K, typename V, typename H, typename E, typename A, typename C>
+void deserializeProjected(std::unordered_map<K, V, H, E, A>& obj, const Value& object, const meta::Projection<C>* projection)
+{
+    if (!projection) {
+        deserialize(obj, object, inPlace);
+        return;
+    }
+    decodeEntries(obj, object,
+        [projection](V& value, const Value& member) { deserializeProjected(value, member, projection); });
+}
+
+} // end of namespace detail
+
+template <typename Class>
+Value serialize(const Class& obj, const meta::Projection<Class>& projection)
+{
+    Value value;
+    detail::ValueArchive(value).saveObject(obj, projection);
+    return value;
+}
+
+template <typename Class>
+void deserialize(Class& obj, const Value& object, const meta::Projection<Class>& projection)
+{
+    if (!object.isObject()) {
+        throw std::runtime_error("Error: can't deserialize from Json::Value to Class.");
+    }
+    meta::doForProjectedMembers(projection,
+        [&obj, &object](auto& member, const auto* nested)
+        {
+            const auto name = member.getNameView();
+            const Value* objName = object.find(name.data(), name.data() + name.size());
+            if (!objName || objName->isNull()) {
+                return;
+            }
+            using MemberT = meta::get_member_type<decltype(member)>;
+            if (member.canGetRef()) { // always true for data members
+                detail::deserializeProjected(member.getRef(obj), *objName, nested);
+            } else if (nested) {
+                auto value = member.getCopy(obj); // keeps members which are not selected
+                detail::deserializeProjected(value, *objName, nested);
+                member.set(obj, std::move(value));
+            } else {
+                member.set(obj, deserialize<MemberT>(*objName));
+            }
+        }
+    );
+}
+
+}
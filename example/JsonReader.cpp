@@ -0,0 +1,424 @@
+#include "JsonReader.h"
+#include "CharScan.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace Json
+{
+
+namespace
+{
+
+bool isWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+void appendUtf8(std::string& out, unsigned codePoint)
+{
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+const char* skipDigits(const char* cur, const char* end)
+{
+    while (cur != end && isDigit(*cur)) {
+        ++cur;
+    }
+    return cur;
+}
+
+// end of number which starts at cur: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?, nullptr if it's
+// not a JSON number. from_chars alone also accepts inf and nan
+const char* scanNumber(const char* cur, const char* end)
+{
+    if (cur != end && *cur == '-') {
+        ++cur;
+    }
+    if (cur == end || !isDigit(*cur)) {
+        return nullptr;
+    }
+    cur = *cur == '0' ? cur + 1 : skipDigits(cur, end);
+    if (cur != end && *cur == '.') {
+        const char* digits = ++cur;
+        cur = skipDigits(cur, end);
+        if (cur == digits) {
+            return nullptr;
+        }
+    }
+    if (cur != end && (*cur == 'e' || *cur == 'E')) {
+        ++cur;
+        if (cur != end && (*cur == '+' || *cur == '-')) {
+            ++cur;
+        }
+        const char* digits = cur;
+        cur = skipDigits(cur, end);
+        if (cur == digits) {
+            return nullptr;
+        }
+    }
+    return cur;
+}
+
+// true if number in [begin, end) which doesn't fit into double is too big rather than too small:
+// its decimal exponent (integer digits or minus leading zeros of fraction, plus exponent) is positive
+bool isOverflow(const char* begin, const char* end)
+{
+    const char* cur = *begin == '-' ? begin + 1 : begin;
+    while (cur != end && (*cur == '0' || *cur == '.')) {
+        ++cur;
+    }
+    long long magnitude = 0;
+    if (cur != end && isDigit(*cur)) { // first significant digit
+        const char* point = std::find(begin, end, '.');
+        const char* first = cur;
+        magnitude = first < point ? point - first : -(first - point - 1);
+    }
+    const char* e = std::find_if(begin, end, [](char c) { return c == 'e' || c == 'E'; });
+    if (e != end) {
+        const char* digits = e + 1;
+        const bool negative = *digits == '-';
+        digits += *digits == '-' || *digits == '+';
+        long long exponent = 0;
+        if (std::from_chars(digits, end, exponent).ec != std::errc()) {
+            return !negative; // exponent is huge, it decides
+        }
+        magnitude += negative ? -exponent : exponent;
+    }
+    return magnitude > 0;
+}
+
+} // end of anonymous namespace
+
+PullParser::PullParser(const char* begin, const char* end) :
+    begin(begin),
+    cur(begin),
+    end(end),
+    depth(0)
+{ }
+
+void PullParser::skipWhitespace()
+{
+    while (cur != end && isWhitespace(*cur)) {
+        ++cur;
+    }
+}
+
+char PullParser::peek()
+{
+    skipWhitespace();
+    return cur != end ? *cur : '\0';
+}
+
+bool PullParser::consume(char c)
+{
+    if (peek() == c) {
+        ++cur;
+        return true;
+    }
+    return false;
+}
+
+void PullParser::expect(char c)
+{
+    if (!consume(c)) {
+        const char message[] = { 'e', 'x', 'p', 'e', 'c', 't', 'e', 'd', ' ', '\'', c, '\'', '\0' };
+        error(message);
+    }
+}
+
+void PullParser::enter()
+{
+    if (++depth > maxDepth) {
+        error("too deeply nested");
+    }
+}
+
+bool PullParser::beginObject()
+{
+    expect('{');
+    enter();
+    if (consume('}')) {
+        --depth;
+        return false;
+    }
+    return true;
+}
+
+std::string_view PullParser::readKey(std::string& scratch)
+{
+    const auto key = readStringView(scratch);
+    expect(':');
+    return key;
+}
+
+bool PullParser::nextMember()
+{
+    if (consume(',')) {
+        return true;
+    }
+    expect('}');
+    --depth;
+    return false;
+}
+
+bool PullParser::beginArray()
+{
+    expect('[');
+    enter();
+    if (consume(']')) {
+        --depth;
+        return false;
+    }
+    return true;
+}
+
+bool PullParser::nextElement()
+{
+    if (consume(',')) {
+        return true;
+    }
+    expect(']');
+    --depth;
+    return false;
+}
+
+void PullParser::expectLiteral(const char* literal, std::size_t size)
+{
+    if (static_cast<std::size_t>(end - cur) < size || std::memcmp(cur, literal, size) != 0) {
+        error("unexpected token");
+    }
+    cur += size;
+}
+
+bool PullParser::readNull()
+{
+    if (peek() != 'n') {
+        return false;
+    }
+    expectLiteral("null", 4);
+    return true;
+}
+
+bool PullParser::readBool()
+{
+    const char c = peek();
+    if (c == 't') {
+        expectLiteral("true", 4);
+        return true;
+    } else if (c == 'f') {
+        expectLiteral("false", 5);
+        return false;
+    } else if (readNull()) {
+        return false;
+    }
+    error("expected bool");
+}
+
+double PullParser::readDouble()
+{
+    skipWhitespace();
+    if (readNull()) {
+        return 0.0;
+    }
+    const char* stop = scanNumber(cur, end);
+    if (!stop) {
+        error("expected number");
+    }
+    double value = 0.0;
+    const auto result = std::from_chars(cur, stop, value);
+    if (result.ec == std::errc::result_out_of_range) { // the same as strtod in JsonCpp, e.g. 1e+9999 is inf
+        const double huge = isOverflow(cur, stop) ? HUGE_VAL : 0.0;
+        value = *cur == '-' ? -huge : huge;
+    } else if (result.ec != std::errc() || result.ptr != stop) {
+        error("expected number");
+    }
+    cur = stop;
+    return value;
+}
+
+long long PullParser::readInt()
+{
+    skipWhitespace();
+    if (readNull()) {
+        return 0;
+    }
+    const char* start = cur;
+    long long value = 0;
+    const auto result = std::from_chars(cur, end, value);
+    if (result.ec != std::errc()) {
+        error("expected integer");
+    }
+    cur = result.ptr;
+    if (cur != end && (*cur == '.' || *cur == 'e' || *cur == 'E')) {
+        cur = start; // real number, truncated like Json::Value::asInt does
+        return static_cast<long long>(readDouble());
+    }
+    return value;
+}
+
+unsigned long long PullParser::readUInt()
+{
+    skipWhitespace();
+    if (readNull()) {
+        return 0;
+    }
+    const char* start = cur;
+    unsigned long long value = 0;
+    const auto result = std::from_chars(cur, end, value);
+    if (result.ec != std::errc()) {
+        error("expected unsigned integer");
+    }
+    cur = result.ptr;
+    if (cur != end && (*cur == '.' || *cur == 'e' || *cur == 'E')) {
+        cur = start;
+        return static_cast<unsigned long long>(readDouble());
+    }
+    return value;
+}
+
+std::string_view PullParser::readStringView(std::string& scratch)
+{
+    expect('"');
+    const char* start = cur;
+    const char* stop = CharScan::findQuoteOrEscape(cur, end);
+    if (stop == end) {
+        error("unterminated string");
+    }
+    if (*stop == '"') { // no escapes, can point into the buffer
+        cur = stop + 1;
+        return std::string_view(start, stop - start);
+    }
+    scratch.clear();
+    decodeString(scratch);
+    return scratch;
+}
+
+void PullParser::readString(std::string& out)
+{
+    expect('"');
+    out.clear(); // keeps capacity
+    decodeString(out);
+}
+
+void PullParser::decodeString(std::string& out)
+{
+    for (;;) {
+        const char* stop = CharScan::findQuoteOrEscape(cur, end);
+        if (stop == end) {
+            error("unterminated string");
+        }
+        out.append(cur, stop);
+        cur = stop + 1;
+        if (*stop == '"') {
+            return;
+        }
+        if (cur == end) {
+            error("unterminated string");
+        }
+        const char escaped = *cur++;
+        switch (escaped) {
+        case '"': out.push_back('"'); break;
+        case '\\': out.push_back('\\'); break;
+        case '/': out.push_back('/'); break;
+        case 'b': out.push_back('\b'); break;
+        case 'f': out.push_back('\f'); break;
+        case 'n': out.push_back('\n'); break;
+        case 'r': out.push_back('\r'); break;
+        case 't': out.push_back('\t'); break;
+        case 'u': {
+            auto readHex = [this]()
+            {
+                unsigned value = 0;
+                if (end - cur < 4 || std::from_chars(cur, cur + 4, value, 16).ptr != cur + 4) {
+                    error("bad unicode escape");
+                }
+                cur += 4;
+                return value;
+            };
+            unsigned codePoint = readHex();
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF) { // surrogate pair
+                if (end - cur < 2 || cur[0] != '\\' || cur[1] != 'u') {
+                    error("expected low surrogate");
+                }
+                cur += 2;
+                const unsigned low = readHex();
+                if (low < 0xDC00 || low > 0xDFFF) {
+                    error("bad low surrogate");
+                }
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            }
+            appendUtf8(out, codePoint);
+            break;
+        }
+        default:
+            error("bad escape sequence");
+        }
+    }
+}
+
+void PullParser::skipValue()
+{
+    const char c = peek();
+    if (c == '{') {
+        if (beginObject()) {
+            std::string scratch;
+            do {
+                readKey(scratch);
+                skipValue();
+            } while (nextMember());
+        }
+    } else if (c == '[') {
+        if (beginArray()) {
+            do {
+                skipValue();
+            } while (nextElement());
+        }
+    } else if (c == '"') {
+        std::string scratch;
+        readString(scratch);
+    } else if (c == 't' || c == 'f') {
+        readBool();
+    } else if (c == 'n') {
+        readNull();
+    } else {
+        readDouble();
+    }
+}
+
+void PullParser::finish()
+{
+    if (peek() != '\0' || cur != end) {
+        error("unexpected data after JSON value");
+    }
+}
+
+void PullParser::error(const char* what) const
+{
+    throw std::runtime_error(std::string("Error: can't parse JSON at offset ") +
+        std::to_string(cur - begin) + ": " + what);
+}
+
+}
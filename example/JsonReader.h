@@ -0,0 +1,137 @@
+// Streaming JSON deserialization: JSON text is parsed token by token and decoded straight into
+// registered objects, without building Json::Value tree first.
+//
+// Object keys are dispatched through meta::memberIndex, so each key costs one lookup in the
+// class's name index, unknown keys are skipped. Decoding follows the same rules as
+// Json::deserialize(obj, value, Json::inPlace): members are read through references when possible,
+// strings and containers keep their storage, keys missing from JSON leave members untouched.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <Meta.h>
+#include <LazyView.h>
+#include <Projection.h>
+#include "MemoryResource.h"
+#include "StringCast.h"
+
+namespace Json
+{
+
+// Pull parser over a buffer of JSON text. It doesn't own the buffer.
+// All functions skip whitespace before the token they read and throw std::runtime_error on bad input.
+// Objects and arrays nested deeper than maxDepth are rejected, so hostile input can't exhaust the stack
+class PullParser {
+public:
+    static constexpr unsigned maxDepth = 1000; // the same as default stackLimit of Json::CharReader
+
+    PullParser(const char* begin, const char* end);
+
+    // next non-whitespace char or '\0' if there's nothing left
+    char peek();
+    // consumes c if it's the next token
+    bool consume(char c);
+    void expect(char c);
+
+    // consumes '{', returns false if object is empty (and consumes '}' too)
+    bool beginObject();
+    // reads "key": and returns key. If key has no escapes, view points into the buffer,
+    // otherwise it's decoded to scratch
+    std::string_view readKey(std::string& scratch);
+    // consumes ',' and returns true or consumes '}' and returns false
+    bool nextMember();
+
+    // the same for arrays
+    bool beginArray();
+    bool nextElement();
+
+    bool readNull(); // consumes null if it's the next token
+    bool readBool();
+    double readDouble();
+    long long readInt();
+    unsigned long long readUInt();
+    std::string_view readStringView(std::string& scratch); // view into buffer or scratch, like readKey
+    void readString(std::string& out); // assigns to out, keeps its capacity
+
+    void skipValue();
+    // throws if there's anything except whitespace left
+    void finish();
+
+    std::size_t offset() const { return cur - begin; }
+    const char* position() const { return cur; }
+    [[noreturn]] void error(const char* what) const;
+
+private:
+    void skipWhitespace();
+    void enter(); // object or array is opened, throws if it's nested too deep
+    void expectLiteral(const char* literal, std::size_t size);
+    void decodeString(std::string& out); // cur points after opening quote
+
+    const char* begin;
+    const char* cur;
+    const char* end;
+    unsigned depth;
+};
+
+/////////////////// ENTRY POINTS
+
+template <typename Class>
+void read(Class& obj, const char* begin, const char* end);
+
+template <typename Class>
+void read(Class& obj, std::string_view text);
+
+// Classes with registered constructor are built with meta::constructFrom, see LazyView.h
+template <typename Class>
+Class read(std::string_view text);
+
+// Class is constructed with resource, see MemoryResource.h
+template <typename Class>
+Class read(std::string_view text, std::pmr::memory_resource* resource);
+
+// only members selected by projection are decoded, values of other keys are skipped
+// without being decoded. See Projection.h
+template <typename Class>
+void read(Class& obj, std::string_view text, const meta::Projection<Class>& projection);
+
+/////////////////// READING VALUES
+
+// registered classes, numbers, bools and strings.
+// Other values are skipped and obj is reset to T(), the same as Json::deserialize_basic does
+template <typename T>
+void readValue(PullParser& parser, T& obj);
+
+template <typename Traits, typename Alloc>
+void readValue(PullParser& parser, std::basic_string<char, Traits, Alloc>& obj);
+
+// New elements of classes which have registered constructor and no default one are built with
+// meta::constructFrom, existing elements are decoded in place
+template <typename T, typename A>
+void readValue(PullParser& parser, std::vector<T, A>& obj);
+
+template <typename K, typename V, typename H, typename E, typename A>
+void readValue(PullParser& parser, std::unordered_map<K, V, H, E, A>& obj);
+
+/////////////////// LAZY VIEWS
+
+// Format for meta::lazy_view, see LazyView.h. Values of members are skipped when view is
+// constructed and decoded with readValue when accessed. Null members are treated as missing
+struct LazyFormat {
+    template <typename Class, std::size_t N>
+    static void findMembers(std::string_view data, std::array<std::string_view, N>& spans);
+
+    template <typename T>
+    static void decode(std::string_view encoded, T& value);
+};
+
+template <typename Class>
+using LazyView = meta::lazy_view<Class, LazyFormat>;
+
+}
+
+#include "JsonReader.inl"
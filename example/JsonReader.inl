@@ -0,0 +1,358 @@
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace Json
+{
+
+/////////////////// ENTRY POINTS
+
+namespace detail
+{
+
+template <typename Class>
+void readObject(PullParser& parser, Class& obj, const meta::Projection<Class>& projection);
+
+} // end of namespace detail
+
+template <typename Class>
+void read(Class& obj, const char* begin, const char* end)
+{
+    PullParser parser(begin, end);
+    readValue(parser, obj);
+    parser.finish();
+}
+
+template <typename Class>
+void read(Class& obj, std::string_view text)
+{
+    read(obj, text.data(), text.data() + text.size());
+}
+
+template <typename Class>
+Class read(std::string_view text)
+{
+    if constexpr (meta::ctorRegistered<Class>()) {
+        return meta::constructFrom<Class, LazyFormat>(text);
+    } else {
+        Class c;
+        read(c, text);
+        return c;
+    }
+}
+
+template <typename Class>
+Class read(std::string_view text, std::pmr::memory_resource* resource)
+{
+    Class c = makeWithResource<Class>(resource);
+    read(c, text);
+    return c;
+}
+
+template <typename Class>
+void read(Class& obj, std::string_view text, const meta::Projection<Class>& projection)
+{
+    PullParser parser(text.data(), text.data() + text.size());
+    detail::readObject(parser, obj, projection);
+    parser.finish();
+}
+
+/////////////////// READING VALUES
+
+namespace detail
+{
+
+template <typename Class, typename MemberType>
+void readMember(PullParser& parser, Class& obj, const MemberType& member, std::size_t index)
+{
+    using MemberT = meta::get_member_type<MemberType>;
+    meta::detail::countMemberWrite<Class>(index, !member.canGetRef());
+    if (member.canGetRef()) { // always true for data members
+        readValue(parser, member.getRef(obj));
+        return;
+    }
+    if constexpr (std::is_default_constructible<MemberT>::value) {
+        MemberT value{};
+        readValue(parser, value);
+        member.set(obj, std::move(value));
+    } else {
+        parser.error("can't deserialize member: it has no non-const getter and its type is not default constructible");
+    }
+}
+
+template <typename Class>
+void readObject(PullParser& parser, Class& obj)
+{
+    const auto stats = meta::detail::countScope<Class>(meta::detail::StatsOp::Deserialize,
+        [&parser]() { return parser.offset(); });
+    if (!parser.beginObject()) {
+        return;
+    }
+    std::string scratch; // only used for keys with escapes
+    do {
+        const auto index = meta::memberIndex<Class>(parser.readKey(scratch));
+        if (index == meta::npos) {
+            parser.skipValue();
+        } else if (!parser.readNull()) { // null members are skipped, like in Json::deserialize
+            meta::detail::for_tuple_at(index,
+                [&parser, &obj, index](const auto& member)
+                {
+                    readMember(parser, obj, member, index);
+                },
+                meta::getMembers<Class>()
+            );
+        }
+    } while (parser.nextMember());
+}
+
+// nested projection is applied to registered classes, possibly inside of containers,
+// values are read whole when there's no projection
+template <typename T, typename C>
+void readProjected(PullParser& parser, T& obj, const meta::Projection<C>* projection);
+
+template <typename T, typename A, typename C>
+void readProjected(PullParser& parser, std::vector<T, A>& obj, const meta::Projection<C>* projection);
+
+template <typename K, typename V, typename H, typename E, typename A, typename C>
+void readProjected(PullParser& parser, std::unordered_map<K, V, H, E, A>& obj, const meta::Projection<C>* projection);
+
+template <typename Class>
+void readObject(PullParser& parser, Class& obj, const meta::Projection<Class>& projection)
+{
+    if (!parser.beginObject()) {
+        return;
+    }
+    std::string scratch;
+    do {
+        const auto index = meta::memberIndex<Class>(parser.readKey(scratch));
+        if (index == meta::npos || !projection.contains(index)) {
+            parser.skipValue();
+        } else if (!parser.readNull()) {
+            meta::detail::for_tuple_at(index,
+                [&parser, &obj, &projection, index](const auto& member)
+                {
+                    using MemberT = meta::get_member_type<decltype(member)>;
+                    const auto* nested = projection.template getNested<meta::projected_class_t<MemberT>>(index);
+                    if (!nested) {
+                        readMember(parser, obj, member, index);
+                    } else if (member.canGetRef()) {
+                        readProjected(parser, member.getRef(obj), nested);
+                    } else {
+                        auto value = member.getCopy(obj); // keeps members which are not selected
+                        readProjected(parser, value, nested);
+                        member.set(obj, std::move(value));
+                    }
+                },
+                meta::getMembers<Class>()
+            );
+        }
+    } while (parser.nextMember());
+}
+
+// true if new elements of T can't be default constructed and decoded in place
+template <typename T>
+constexpr bool isConstructedFromText()
+{
+    return meta::ctorRegistered<T>() && !std::is_default_constructible<T>::value;
+}
+
+// builds T with meta::constructFrom from the next value, projections don't apply to it.
+// Value is decoded by a parser of its own, so nesting of such values is limited here
+template <typename T>
+T constructElement(PullParser& parser)
+{
+    static thread_local unsigned depth = 0;
+    if (depth == PullParser::maxDepth) {
+        parser.error("too deeply nested");
+    }
+    struct Nested {
+        Nested() { ++depth; }
+        ~Nested() { --depth; }
+    } nested;
+    parser.peek(); // skips whitespace before value
+    const char* begin = parser.position();
+    parser.skipValue();
+    return meta::constructFrom<T, LazyFormat>(std::string_view(begin, parser.position() - begin));
+}
+
+// reads array to obj, calling readElement(parser, elem) for each element
+template <typename T, typename A, typename ReadElement>
+void readElements(PullParser& parser, std::vector<T, A>& obj, ReadElement&& readElement)
+{
+    std::size_t count = 0;
+    if (parser.beginArray()) {
+        do {
+            if (count < obj.size()) {
+                readElement(parser, obj[count]); // existing elements are reused
+            } else if constexpr (isConstructedFromText<T>()) {
+                obj.push_back(constructElement<T>(parser));
+            } else {
+                obj.emplace_back();
+                readElement(parser, obj.back());
+            }
+            ++count;
+        } while (parser.nextElement());
+    }
+    obj.erase(obj.begin() + count, obj.end());
+}
+
+// reads object to obj, calling readEntry(parser, value) for each value
+template <typename K, typename V, typename H, typename E, typename A, typename ReadEntry>
+void readEntries(PullParser& parser, std::unordered_map<K, V, H, E, A>& obj, ReadEntry&& readEntry)
+{
+    // keys of entries which were in map before decoding are remembered to erase ones not present in JSON
+    const bool hadEntries = !obj.empty();
+    std::vector<const K*> seenKeys;
+    seenKeys.reserve(obj.size()); // usually the same keys are decoded again
+    if (parser.beginObject()) {
+        std::string scratch;
+        do {
+            const auto keyStr = parser.readKey(scratch);
+            typename std::unordered_map<K, V, H, E, A>::iterator it;
+            bool decoded = false;
+            if constexpr (isConstructedFromText<V>()) {
+                auto key = fromString<K>(keyStr, obj.get_allocator());
+                it = obj.find(key);
+                if (it == obj.end()) {
+                    it = obj.emplace(std::move(key), constructElement<V>(parser)).first;
+                    decoded = true;
+                }
+            } else if constexpr (std::is_same<K, std::string>::value) {
+                static thread_local std::string key; // keeps its capacity between calls
+                key.assign(keyStr.data(), keyStr.size());
+                it = obj.try_emplace(key).first; // key is copied only if it's not in map yet
+            } else {
+                it = obj.try_emplace(fromString<K>(keyStr, obj.get_allocator())).first;
+            }
+            if (hadEntries) {
+                seenKeys.push_back(&it->first);
+            }
+            if (!decoded) {
+                readEntry(parser, it->second);
+            }
+        } while (parser.nextMember());
+    }
+    if (!hadEntries) {
+        return;
+    }
+    std::sort(seenKeys.begin(), seenKeys.end(), std::less<const K*>());
+    seenKeys.erase(std::unique(seenKeys.begin(), seenKeys.end()), seenKeys.end()); // JSON can repeat keys
+    if (obj.size() == seenKeys.size()) {
+        return;
+    }
+    for (auto it = obj.begin(); it != obj.end();) {
+        const bool seen = std::binary_search(seenKeys.begin(), seenKeys.end(), &it->first, std::less<const K*>());
+        it = seen ? std::next(it) : obj.erase(it);
+    }
+}
+
+template <typename T, typename C>
+void readProjected(PullParser& parser, T& obj, const meta::Projection<C>* projection)
+{
+    if constexpr (meta::isRegistered<T>()) {
+        if (projection) {
+            readObject(parser, obj, *projection);
+            return;
+        }
+    }
+    readValue(parser, obj);
+}
+
+template <typename T, typename A, typename C>
+void readProjected(PullParser& parser, std::vector<T, A>& obj, const meta::Projection<C>* projection)
+{
+    readElements(parser, obj,
+        [projection](PullParser& parser, T& elem) { readProjected(parser, elem, projection); });
+}
+
+template <typename K, typename V, typename H, typename E, typename A, typename C>
+void readProjected(PullParser& parser, std::unordered_map<K, V, H, E, A>& obj, const meta::Projection<C>* projection)
+{
+    readEntries(parser, obj,
+        [projection](PullParser& parser, V& value) { readProjected(parser, value, projection); });
+}
+
+} // end of namespace detail
+
+template <typename T>
+void readValue(PullParser& parser, T& obj)
+{
+    if constexpr (meta::isRegistered<T>()) {
+        detail::readObject(parser, obj);
+    } else if constexpr (std::is_same<T, bool>::value) {
+        obj = parser.readBool();
+    } else if constexpr (std::is_floating_point<T>::value) {
+        obj = static_cast<T>(parser.readDouble());
+    } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+        obj = static_cast<T>(parser.readInt());
+    } else if constexpr (std::is_integral<T>::value) {
+        obj = static_cast<T>(parser.readUInt());
+    } else {
+        parser.skipValue();
+        obj = T();
+    }
+}
+
+template <typename Traits, typename Alloc>
+void readValue(PullParser& parser, std::basic_string<char, Traits, Alloc>& obj)
+{
+    if constexpr (std::is_same<std::basic_string<char, Traits, Alloc>, std::string>::value) {
+        parser.readString(obj);
+    } else {
+        std::string scratch; // only used for strings with escapes
+        const auto str = parser.readStringView(scratch);
+        obj.assign(str.data(), str.size());
+    }
+}
+
+template <typename T, typename A>
+void readValue(PullParser& parser, std::vector<T, A>& obj)
+{
+    detail::readElements(parser, obj,
+        [](PullParser& parser, T& elem) { readValue(parser, elem); });
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void readValue(PullParser& parser, std::unordered_map<K, V, H, E, A>& obj)
+{
+    detail::readEntries(parser, obj,
+        [](PullParser& parser, V& value) { readValue(parser, value); });
+}
+
+/////////////////// LAZY VIEWS
+
+template <typename Class, std::size_t N>
+void LazyFormat::findMembers(std::string_view data, std::array<std::string_view, N>& spans)
+{
+    PullParser parser(data.data(), data.data() + data.size());
+    if (parser.beginObject()) {
+        std::string scratch;
+        do {
+            const auto index = meta::memberIndex<Class>(parser.readKey(scratch));
+            parser.peek(); // skips whitespace before value
+            const char* begin = data.data() + parser.offset();
+            if (parser.readNull()) {
+                if (index != meta::npos) {
+                    spans[index] = std::string_view(); // the last value wins, like in Json::Value
+                }
+                continue;
+            }
+            parser.skipValue();
+            if (index != meta::npos) {
+                spans[index] = std::string_view(begin, data.data() + parser.offset() - begin);
+            }
+        } while (parser.nextMember());
+    }
+    parser.finish();
+}
+
+template <typename T>
+void LazyFormat::decode(std::string_view encoded, T& value)
+{
+    PullParser parser(encoded.data(), encoded.data() + encoded.size());
+    readValue(parser, value);
+    parser.finish();
+}
+
+}
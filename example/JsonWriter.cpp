@@ -0,0 +1,89 @@
+#include "JsonWriter.h"
+#include <json/json.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+namespace Json
+{
+
+void StreamOutput::write(const char* data, std::size_t count)
+{
+    if (size + count > sizeof(buffer)) {
+        flush();
+        if (count > sizeof(buffer)) {
+            os.write(data, count);
+            flushed += count;
+            return;
+        }
+    }
+    std::memcpy(buffer + size, data, count);
+    size += count;
+}
+
+void StreamOutput::flush()
+{
+    os.write(buffer, size);
+    flushed += size;
+    size = 0;
+}
+
+namespace detail
+{
+
+std::size_t formatDouble(char* buffer, double value)
+{
+    // the same as Json::valueToString(double): "%.17g", special values are written as in JsonCpp
+    if (std::isnan(value)) {
+        std::memcpy(buffer, "null", 4);
+        return 4;
+    } else if (std::isinf(value)) {
+        const char* str = value < 0 ? "-1e+9999" : "1e+9999";
+        const std::size_t len = std::strlen(str);
+        std::memcpy(buffer, str, len);
+        return len;
+    }
+    // to_chars with precision is specified to produce the same result as printf in "C" locale
+    auto result = std::to_chars(buffer, buffer + 32, value, std::chars_format::general, 17);
+    return result.ptr - buffer;
+}
+
+std::size_t formatInt(char* buffer, long long value)
+{
+    return std::to_chars(buffer, buffer + 32, value).ptr - buffer;
+}
+
+std::size_t formatUInt(char* buffer, unsigned long long value)
+{
+    return std::to_chars(buffer, buffer + 32, value).ptr - buffer;
+}
+
+std::size_t escapeChar(char* buffer, char c)
+{
+    buffer[0] = '\\';
+    switch (c) {
+    case '"': buffer[1] = '"'; return 2;
+    case '\\': buffer[1] = '\\'; return 2;
+    case '\b': buffer[1] = 'b'; return 2;
+    case '\f': buffer[1] = 'f'; return 2;
+    case '\n': buffer[1] = 'n'; return 2;
+    case '\r': buffer[1] = 'r'; return 2;
+    case '\t': buffer[1] = 't'; return 2;
+    default:
+        // other control chars, uppercase hex like in JsonCpp
+        std::snprintf(buffer + 1, 6, "u%04X", static_cast<unsigned>(static_cast<unsigned char>(c)));
+        return 6;
+    }
+}
+
+void writeValueAsJson(std::string& str, const Value& value)
+{
+    FastWriter writer;
+    writer.omitEndingLineFeed();
+    str += writer.write(value);
+}
+
+} // end of namespace detail
+
+}
@@ -0,0 +1,120 @@
+// Streaming JSON serialization: registered classes are written as JSON text directly to output,
+// without building Json::Value tree first.
+//
+// Output is byte-identical to what Json::FastWriter (with omitEndingLineFeed) produces for
+// Json::serialize(obj), so both paths can be used interchangeably. That's why object keys are
+// written in sorted order (Json::Value stores object members in std::map).
+//
+// Large containers are written in parallel when ThreadPool::Scope is active, see ThreadPool.h
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <json/json-forwards.h>
+
+#include <Archive.h>
+#include <Meta.h>
+#include <Projection.h>
+#include "CharScan.h"
+#include "StringCast.h"
+#include "ThreadPool.h"
+
+namespace Json
+{
+
+// Output which appends to std::string
+class StringOutput {
+public:
+    explicit StringOutput(std::string& str) : str(str) { }
+
+    void put(char c) { str.push_back(c); }
+    void write(const char* data, std::size_t size) { str.append(data, size); }
+    // number of bytes in str, used by stats (see Stats.h)
+    std::size_t written() const { return str.size(); }
+private:
+    std::string& str;
+};
+
+// Output which writes to std::ostream through a small buffer
+class StreamOutput {
+public:
+    explicit StreamOutput(std::ostream& os) : os(os), size(0), flushed(0) { }
+    ~StreamOutput() { flush(); }
+
+    StreamOutput(const StreamOutput&) = delete;
+    StreamOutput& operator=(const StreamOutput&) = delete;
+
+    void put(char c)
+    {
+        if (size == sizeof(buffer)) {
+            flush();
+        }
+        buffer[size++] = c;
+    }
+    void write(const char* data, std::size_t count);
+    void flush();
+    // number of bytes written since construction
+    std::size_t written() const { return flushed + size; }
+private:
+    std::ostream& os;
+    std::size_t size;
+    std::size_t flushed;
+    char buffer[4096];
+};
+
+/////////////////// ENTRY POINTS
+
+// appends JSON text of obj to str
+template <typename Class>
+void write(std::string& str, const Class& obj);
+
+template <typename Class>
+void write(std::ostream& os, const Class& obj);
+
+template <typename Class>
+std::string writeToString(const Class& obj);
+
+// only members selected by projection are written, see Projection.h
+template <typename Class>
+void write(std::string& str, const Class& obj, const meta::Projection<Class>& projection);
+
+template <typename Class>
+void write(std::ostream& os, const Class& obj, const meta::Projection<Class>& projection);
+
+template <typename Class>
+std::string writeToString(const Class& obj, const meta::Projection<Class>& projection);
+
+/////////////////// WRITING VALUES
+
+// Registered classes, numbers, bools, strings, std::vector, std::unordered_map and everything else
+// Json::Value can be constructed from (other types are written as null, the same as Json::serialize
+// does). Values are written through meta::Archive, see detail::WriterArchive
+template <typename Output, typename T>
+void writeValue(Output& out, const T& obj);
+
+// writes quoted string escaped the same way as Json::FastWriter does it
+template <typename Output>
+void writeString(Output& out, const char* str, std::size_t size);
+
+namespace detail
+{
+
+// these return number of chars written to buffer, which should be at least 32 chars long
+std::size_t formatDouble(char* buffer, double value);
+std::size_t formatInt(char* buffer, long long value);
+std::size_t formatUInt(char* buffer, unsigned long long value);
+
+// writes escape sequence for c to buffer (at least 6 chars), returns its length
+std::size_t escapeChar(char* buffer, char c);
+
+void writeValueAsJson(std::string& str, const Value& value); // for Json::Value members
+
+} // end of namespace detail
+
+}
+
+#include "JsonWriter.inl"
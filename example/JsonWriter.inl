@@ -0,0 +1,323 @@
+#include <json/json.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace Json
+{
+
+/////////////////// ENTRY POINTS
+
+namespace detail
+{
+
+template <typename Output, typename Class>
+void writeObject(Output& out, const Class& obj, const meta::Projection<Class>& projection);
+
+} // end of namespace detail
+
+template <typename Class>
+void write(std::string& str, const Class& obj)
+{
+    StringOutput out(str);
+    writeValue(out, obj);
+}
+
+template <typename Class>
+void write(std::ostream& os, const Class& obj)
+{
+    StreamOutput out(os);
+    writeValue(out, obj);
+}
+
+template <typename Class>
+std::string writeToString(const Class& obj)
+{
+    std::string str;
+    write(str, obj);
+    return str;
+}
+
+template <typename Class>
+void write(std::string& str, const Class& obj, const meta::Projection<Class>& projection)
+{
+    StringOutput out(str);
+    detail::writeObject(out, obj, projection);
+}
+
+template <typename Class>
+void write(std::ostream& os, const Class& obj, const meta::Projection<Class>& projection)
+{
+    StreamOutput out(os);
+    detail::writeObject(out, obj, projection);
+}
+
+template <typename Class>
+std::string writeToString(const Class& obj, const meta::Projection<Class>& projection)
+{
+    std::string str;
+    write(str, obj, projection);
+    return str;
+}
+
+/////////////////// WRITING VALUES
+
+namespace detail
+{
+
+// Members in the order Json::Value writes them (sorted by name) and their keys, already
+// escaped and quoted with separators: "\"name\":" for the first member, ",\"name\":" for others.
+// slots[index] is the position of member with that index in order. Built once per class
+template <typename Class>
+struct ObjectKeys {
+    std::array<std::size_t, meta::getMemberCount<Class>()> order;
+    std::array<std::size_t, meta::getMemberCount<Class>()> slots;
+    std::array<std::string, meta::getMemberCount<Class>()> keys;
+};
+
+template <typename Class>
+const ObjectKeys<Class>& getObjectKeys()
+{
+    static const auto objectKeys = []()
+    {
+        ObjectKeys<Class> objectKeys{};
+        auto& order = objectKeys.order;
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        const auto& accessors = meta::getMemberAccessors<Class>();
+        std::sort(order.begin(), order.end(),
+            [&accessors](std::size_t a, std::size_t b)
+            {
+                return std::strcmp(accessors[a].name, accessors[b].name) < 0;
+            }
+        );
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            objectKeys.slots[order[i]] = i;
+            auto& key = objectKeys.keys[i];
+            StringOutput out(key);
+            if (i != 0) {
+                out.put(',');
+            }
+            writeString(out, accessors[order[i]].name, std::strlen(accessors[order[i]].name));
+            out.put(':');
+        }
+        return objectKeys;
+    }();
+    return objectKeys;
+}
+
+// map is written in key order to match Json::Value
+// string keys are not copied, others are converted with castToString
+template <typename K, typename V, typename H, typename E, typename A>
+auto sortMapEntries(const std::unordered_map<K, V, H, E, A>& obj)
+{
+    using key_t = std::conditional_t<is_basic_string<K>::value, std::string_view, std::string>;
+    std::vector<std::pair<key_t, const V*>> sorted;
+    sorted.reserve(obj.size());
+    for (auto& pair : obj) {
+        if constexpr (is_basic_string<K>::value) {
+            sorted.emplace_back(std::string_view(pair.first.data(), pair.first.size()), &pair.second);
+        } else {
+            sorted.emplace_back(castToString(pair.first), &pair.second);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    return sorted;
+}
+
+// writes elements [0, count) with write(out, begin, end), in parallel chunks if container is big enough
+template <typename Output, typename WriteRange>
+void writeRange(Output& out, std::size_t count, WriteRange&& write)
+{
+    ThreadPool* pool = ThreadPool::currentFor(count);
+    if (!pool) {
+        write(out, 0, count);
+        return;
+    }
+    pool->encodeChunked<std::string>(count,
+        [&write](std::string& chunk, std::size_t begin, std::size_t end)
+        {
+            StringOutput chunkOut(chunk);
+            write(chunkOut, begin, end);
+        },
+        [&out](const std::string& chunk)
+        {
+            out.write(chunk.data(), chunk.size());
+        }
+    );
+}
+
+// Writes values through meta::Archive traversal, members in the order of getObjectKeys
+template <typename Output>
+class WriterArchive : public meta::Archive<WriterArchive<Output>> {
+public:
+    static constexpr bool keepsMemberOrder = false;
+
+    explicit WriterArchive(Output& out) : out(out) { }
+
+    template <typename Class>
+    static const auto& memberOrder() { return getObjectKeys<Class>().order; }
+
+    std::size_t written() const { return out.written(); }
+
+    template <typename Class>
+    std::size_t beginObject()
+    {
+        out.put('{');
+        return 0;
+    }
+
+    template <typename Class>
+    void key(std::size_t position, std::size_t index)
+    {
+        const auto& objectKeys = getObjectKeys<Class>();
+        const std::size_t slot = objectKeys.slots[index];
+        const auto& key = objectKeys.keys[slot];
+        const std::size_t skip = position == 0 && slot != 0 ? 1 : 0; // members before it were skipped by projection
+        out.write(key.data() + skip, key.size() - skip);
+    }
+
+    template <typename Class>
+    void endObject(std::size_t) { out.put('}'); }
+
+    void beginSequence(std::size_t) { out.put('['); }
+    void element(std::size_t i)
+    {
+        if (i != 0) {
+            out.put(',');
+        }
+    }
+    void endSequence() { out.put(']'); }
+
+    void beginMap(std::size_t) { out.put('{'); }
+    void mapKey(std::string_view key, std::size_t i)
+    {
+        element(i);
+        writeString(out, key.data(), key.size());
+        out.put(':');
+    }
+    void endMap() { out.put('}'); }
+
+    template <typename T>
+    void scalar(const T& obj);
+
+    // big containers are written in parallel chunks, maps in key order to match Json::Value
+    template <typename T, typename A, typename SaveElement>
+    void saveElements(const std::vector<T, A>& obj, SaveElement&& saveElement);
+
+    template <typename K, typename V, typename H, typename E, typename A, typename SaveElement>
+    void saveEntries(const std::unordered_map<K, V, H, E, A>& obj, SaveElement&& saveElement);
+
+private:
+    Output& out;
+};
+
+template <typename Output>
+template <typename T>
+void WriterArchive<Output>::scalar(const T& obj)
+{
+    if constexpr (is_basic_string<T>::value) {
+        writeString(out, obj.data(), obj.size());
+    } else if constexpr (!std::is_constructible<Value, T>::value) {
+        out.write("null", 4); // Json::serialize_basic returns null for unknown types
+    } else if constexpr (std::is_same<T, bool>::value) {
+        obj ? out.write("true", 4) : out.write("false", 5);
+    } else if constexpr (std::is_arithmetic<T>::value) {
+        char buffer[32];
+        if constexpr (std::is_floating_point<T>::value) {
+            out.write(buffer, formatDouble(buffer, obj)); // floats are stored as doubles in Json::Value
+        } else if constexpr (std::is_signed<T>::value) {
+            out.write(buffer, formatInt(buffer, obj));
+        } else {
+            out.write(buffer, formatUInt(buffer, obj));
+        }
+    } else if constexpr (std::is_convertible<T, const char*>::value) {
+        writeString(out, obj, std::strlen(obj));
+    } else {
+        std::string str;
+        writeValueAsJson(str, Value(obj));
+        out.write(str.data(), str.size());
+    }
+}
+
+template <typename Output>
+template <typename T, typename A, typename SaveElement>
+void WriterArchive<Output>::saveElements(const std::vector<T, A>& obj, SaveElement&& saveElement)
+{
+    beginSequence(obj.size());
+    writeRange(out, obj.size(),
+        [&obj, &saveElement](auto& rangeOut, std::size_t begin, std::size_t end)
+        {
+            WriterArchive<std::decay_t<decltype(rangeOut)>> archive(rangeOut);
+            for (std::size_t i = begin; i != end; ++i) {
+                archive.element(i);
+                saveElement(archive, static_cast<const T&>(obj[i]));
+            }
+        }
+    );
+    endSequence();
+}
+
+template <typename Output>
+template <typename K, typename V, typename H, typename E, typename A, typename SaveElement>
+void WriterArchive<Output>::saveEntries(const std::unordered_map<K, V, H, E, A>& obj, SaveElement&& saveElement)
+{
+    const auto sorted = sortMapEntries(obj);
+    beginMap(sorted.size());
+    writeRange(out, sorted.size(),
+        [&sorted, &saveElement](auto& rangeOut, std::size_t begin, std::size_t end)
+        {
+            WriterArchive<std::decay_t<decltype(rangeOut)>> archive(rangeOut);
+            for (std::size_t i = begin; i != end; ++i) {
+                archive.mapKey(sorted[i].first, i);
+                saveElement(archive, *sorted[i].second);
+            }
+        }
+    );
+    endMap();
+}
+
+} // end of namespace detail
+
+template <typename Output, typename T>
+void writeValue(Output& out, const T& obj)
+{
+    detail::WriterArchive<Output>(out).save(obj);
+}
+
+namespace detail
+{
+
+template <typename Output, typename Class>
+void writeObject(Output& out, const Class& obj, const meta::Projection<Class>& projection)
+{
+    WriterArchive<Output>(out).saveObject(obj, projection);
+}
+
+} // end of namespace detail
+
+template <typename Output>
+void writeString(Output& out, const char* str, std::size_t size)
+{
+    const char* end = str + size;
+    out.put('"');
+    while (str != end) {
+        const char* escaped = CharScan::findEscaped(str, end);
+        out.write(str, escaped - str);
+        if (escaped == end) {
+            break;
+        }
+        char buffer[8];
+        out.write(buffer, detail::escapeChar(buffer, *escaped));
+        str = escaped + 1;
+    }
+    out.put('"');
+}
+
+}
@@ -0,0 +1,36 @@
+// Deserializers can construct objects which allocate from std::pmr::memory_resource, e.g. from
+// request scoped std::pmr::monotonic_buffer_resource which frees everything at once.
+//
+// Memory resource reaches members through uses-allocator construction: the object passed to
+// Json::deserialize, Json::read or Binary::deserialize with a resource is constructed with
+// polymorphic_allocator if it's allocator aware (has allocator_type and constructor which takes
+// allocator, see makeWithResource). Then its pmr members are decoded in place, and pmr containers
+// pass their allocator to elements they create, so nested strings, vectors and map nodes use
+// the same resource. std::vector, std::unordered_map and std::basic_string with any allocators
+// are supported by all backends.
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+
+// Constructs T with alloc if T is allocator aware: T(std::allocator_arg, alloc) or T(alloc),
+// default constructs T otherwise
+template <typename T, typename Alloc>
+T makeWithAllocator(const Alloc& alloc)
+{
+    if constexpr (!std::uses_allocator<T, Alloc>::value) {
+        return T();
+    } else if constexpr (std::is_constructible<T, std::allocator_arg_t, const Alloc&>::value) {
+        return T(std::allocator_arg, alloc);
+    } else {
+        return T(alloc);
+    }
+}
+
+template <typename T>
+T makeWithResource(std::pmr::memory_resource* resource)
+{
+    return makeWithAllocator<T>(std::pmr::polymorphic_allocator<std::byte>(resource));
+}
@@ -13,7 +13,7 @@ namespace meta
 {
 
 template <>
-inline auto registerMembers<MovieInfo>()
+constexpr auto registerMembers<MovieInfo>()
 {
     return members(
         member("name", &MovieInfo::name),
@@ -34,6 +34,12 @@ struct Person {
         this->name = name;
     }
 
+    void setName(std::string&& name)
+    {
+        std::cout << "Name is moved by calling rvalue setter!\n";
+        this->name = std::move(name);
+    }
+
     const std::string& getName() const
     {
         std::cout << "Got name with setter!\n";
@@ -52,14 +58,15 @@ namespace meta
 {
 
 template <>
-inline auto registerMembers<Person>()
+constexpr auto registerMembers<Person>()
 {
     return members(
         member("age", &Person::getAge, &Person::setAge), // access through getter/setter only!
-        member("name", &Person::getName, &Person::setName), // same, but ref getter/setter
+        member("name", &Person::getName, &Person::setName) // same, but ref getter/setter
+            .addRvalueSetter(&Person::setName), // and rvalues are moved with setName(std::string&&)
         member("salary", &Person::salary),
         member("favouriteMovies", &Person::favouriteMovies)
     );
 }
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "Snapshot.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Snapshot
+{
+
+namespace
+{
+
+constexpr char magic[8] = { 'M', 'E', 'T', 'A', 'S', 'N', 'A', 'P' };
+constexpr std::uint32_t version = 2;
+constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+// header: magic, version, byte order mark, schema hash, root offset, max alignment
+constexpr std::size_t versionPosition = 8;
+constexpr std::size_t byteOrderPosition = 12;
+constexpr std::size_t schemaHashPosition = 16;
+constexpr std::size_t rootPosition = 24;
+constexpr std::size_t maxAlignPosition = 32;
+
+template <typename T>
+T fetchAt(std::string_view data, std::size_t position)
+{
+    T value;
+    std::memcpy(&value, data.data() + position, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void storeAt(std::string& out, std::size_t position, T value)
+{
+    std::memcpy(&out[position], &value, sizeof(T));
+}
+
+}
+
+const char* Data::at(std::uint64_t offset, std::uint64_t size) const
+{
+    if (offset > bytes.size() || size > bytes.size() - offset) {
+        throw std::runtime_error("Error: snapshot is corrupted, offset " + std::to_string(offset) +
+            " is out of range");
+    }
+    return bytes.data() + offset;
+}
+
+namespace detail
+{
+
+void writeHeader(std::string& out, std::uint64_t schemaHash, std::uint64_t maxAlign, std::uint64_t root)
+{
+    std::memcpy(&out[0], magic, sizeof(magic));
+    storeAt(out, versionPosition, version);
+    storeAt(out, byteOrderPosition, byteOrderMark);
+    storeAt(out, schemaHashPosition, schemaHash);
+    storeAt(out, rootPosition, root);
+    storeAt(out, maxAlignPosition, maxAlign);
+}
+
+std::uint64_t readHeader(std::string_view data, std::uint64_t schemaHash, std::uint64_t maxAlign)
+{
+    if (data.size() < headerSize || std::memcmp(data.data(), magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Error: data is not a snapshot");
+    }
+    if (fetchAt<std::uint32_t>(data, versionPosition) != version) {
+        throw std::runtime_error("Error: unsupported snapshot version");
+    }
+    if (fetchAt<std::uint32_t>(data, byteOrderPosition) != byteOrderMark) {
+        throw std::runtime_error("Error: snapshot was written on a host with different byte order");
+    }
+    if (fetchAt<std::uint64_t>(data, schemaHashPosition) != schemaHash) {
+        throw std::runtime_error("Error: snapshot was written from a different class or version of it");
+    }
+    if (fetchAt<std::uint64_t>(data, maxAlignPosition) != maxAlign) {
+        throw std::runtime_error("Error: snapshot was written on a host with different alignment of numbers");
+    }
+    return fetchAt<std::uint64_t>(data, rootPosition);
+}
+
+void writeBytesToFile(const std::string& path, std::string_view bytes)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), bytes.size());
+    if (!file) {
+        throw std::runtime_error("Error: can't write snapshot to '" + path + "'");
+    }
+}
+
+std::pair<std::uint64_t, std::uint64_t> readReference(const Data& data, std::uint64_t at)
+{
+    std::uint64_t reference[2];
+    std::memcpy(reference, data.at(at, sizeof(reference)), sizeof(reference));
+    return { reference[0], reference[1] };
+}
+
+} // end of namespace detail
+
+#ifdef _WIN32
+
+// no mapping here, file is read into memory
+MappedFile::MappedFile(const std::string& path) : ptr(nullptr), length(0)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Error: can't open '" + path + "'");
+    }
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    length = bytes.size();
+    char* buffer = new char[length + 1];
+    std::memcpy(buffer, bytes.data(), length);
+    ptr = buffer;
+}
+
+MappedFile::~MappedFile()
+{
+    delete[] ptr;
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) : ptr(nullptr), length(0)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Error: can't open '" + path + "'");
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Error: can't get size of '" + path + "'");
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    if (length != 0) { // mmap of zero bytes fails
+        void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Error: can't map '" + path + "'");
+        }
+        ptr = static_cast<const char*>(mapped);
+    }
+    ::close(fd); // mapping keeps the file
+}
+
+MappedFile::~MappedFile()
+{
+    if (ptr) {
+        ::munmap(const_cast<char*>(ptr), length);
+    }
+}
+
+#endif
+
+}
@@ -0,0 +1,225 @@
+// Flat snapshot format for memory mapping: registered objects are stored in a fixed layout derived
+// from registerMembers, so a snapshot file can be mapped and read in place without parsing.
+//
+//     Snapshot::writeFile("cache.snap", cache);
+//     ...
+//     Snapshot::MappedFile file("cache.snap");
+//     auto root = Snapshot::open<Cache>(file.data());    // checks header, doesn't decode anything
+//     auto movies = root.get<std::vector<MovieInfo>>("movies"); // Snapshot::ArrayView<MovieInfo>
+//     float rating = movies[42].get<float>("rating");
+//
+// Layout (values are in host byte order, snapshots are not portable between little- and big-endian):
+// - header: magic, version, byte order mark, meta::schemaHash of root class, offset of root object
+//   and the biggest alignment of records in the layout. Snapshot can only be opened as the class it
+//   was written from (with the same schema) on a host which aligns numbers the same way
+// - bool, numbers, enums: sizeof(T) bytes aligned to alignof(T)
+// - strings: 8 byte offset + 8 byte length of bytes stored elsewhere in the snapshot
+// - std::vector<T>: 8 byte offset + 8 byte count of contiguous array of T records
+// - std::unordered_map<K, V>: the same, array of (K, V) records sorted by key, so lookups are
+//   binary searches. Keys should be strings or numbers
+// - registered class: record of its members in registration order, each aligned to its alignment.
+//   Records have fixed size, nested registered objects are stored inline
+// All offsets are relative to the beginning of snapshot.
+//
+// Views only keep a pointer to the data, which should outlive them. Offsets and sizes are checked
+// when strings and arrays are accessed, std::runtime_error is thrown if they point outside of data.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Meta.h>
+#include "StringCast.h"
+
+namespace Snapshot
+{
+
+// Read-only memory mapping of a whole file, throws std::runtime_error if file can't be mapped
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view data() const { return std::string_view(ptr, length); }
+private:
+    const char* ptr;
+    std::size_t length;
+};
+
+// Snapshot bytes, offsets are checked before memory is accessed
+class Data {
+public:
+    explicit Data(std::string_view bytes) : bytes(bytes) { }
+
+    // pointer to 'size' bytes at 'offset', throws if they're not inside of data
+    const char* at(std::uint64_t offset, std::uint64_t size) const;
+    std::size_t size() const { return bytes.size(); }
+private:
+    std::string_view bytes;
+};
+
+template <typename Class>
+class ObjectView;
+
+template <typename T>
+class ArrayView;
+
+template <typename K, typename V>
+class MapView;
+
+namespace detail
+{
+
+// view type of stored T: numbers, bools and enums are read by value, strings are std::string_view
+template <typename T, typename = void>
+struct view_of {
+    using type = T;
+};
+
+template <typename Traits, typename Alloc>
+struct view_of<std::basic_string<char, Traits, Alloc>> {
+    using type = std::string_view;
+};
+
+template <typename T, typename A>
+struct view_of<std::vector<T, A>> {
+    using type = ArrayView<T>;
+};
+
+template <typename K, typename V, typename H, typename E, typename A>
+struct view_of<std::unordered_map<K, V, H, E, A>> {
+    using type = MapView<K, V>;
+};
+
+template <typename T>
+struct view_of<T, std::enable_if_t<meta::isRegistered<T>()>> {
+    using type = ObjectView<T>;
+};
+
+} // end of namespace detail
+
+template <typename T>
+using view_t = typename detail::view_of<T>::type;
+
+/////////////////// ENTRY POINTS
+
+template <typename Class>
+std::string write(const Class& obj);
+
+// writes snapshot to file at 'path', replacing it
+template <typename Class>
+void writeFile(const std::string& path, const Class& obj);
+
+// Checks header of snapshot and returns view of its root object.
+// Throws std::runtime_error if data is not a snapshot of Class
+template <typename Class>
+ObjectView<Class> open(std::string_view data);
+
+// decodes the whole snapshot into objects
+template <typename Class>
+Class load(std::string_view data);
+
+/////////////////// VIEWS
+
+template <typename Class>
+class ObjectView {
+    static_assert(meta::isRegistered<Class>(), "Class is not registered");
+public:
+    ObjectView(const Data& data, std::uint64_t offset);
+
+    // view of member with index I in getMembers<Class>() tuple
+    template <std::size_t I>
+    auto get() const;
+
+    // view of member named 'name', throws std::runtime_error if there's no such member
+    // or it doesn't have type T
+    template <typename T>
+    view_t<T> get(std::string_view name) const;
+
+    // decodes object
+    Class load() const;
+    void load(Class& obj) const;
+
+private:
+    template <typename T, std::size_t... I>
+    std::optional<view_t<T>> find(std::size_t index, std::index_sequence<I...>) const;
+    template <typename T, std::size_t I>
+    void getIfSame(std::optional<view_t<T>>& result) const;
+
+    Data data;
+    std::uint64_t offset;
+};
+
+template <typename T>
+class ArrayView {
+public:
+    class iterator {
+    public:
+        iterator(const ArrayView* array, std::size_t index) : array(array), index(index) { }
+        view_t<T> operator*() const { return (*array)[index]; }
+        iterator& operator++() { ++index; return *this; }
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+    private:
+        const ArrayView* array;
+        std::size_t index;
+    };
+
+    ArrayView(const Data& data, std::uint64_t offset, std::uint64_t count);
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    view_t<T> operator[](std::size_t i) const;
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, count); }
+
+    // elements themselves for arrays of numbers, they are aligned if data is aligned to 8 bytes
+    template <typename U = T, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+    const T* data() const { return reinterpret_cast<const T*>(items.at(offset, count * sizeof(T))); }
+
+private:
+    Data items;
+    std::uint64_t offset;
+    std::size_t count;
+};
+
+template <typename K, typename V>
+class MapView {
+    static_assert(std::is_arithmetic<K>::value || is_basic_string<K>::value,
+        "Snapshot map keys should be numbers or strings");
+public:
+    using key_type = std::conditional_t<is_basic_string<K>::value, std::string_view, K>;
+
+    MapView(const Data& data, std::uint64_t offset, std::uint64_t count);
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    // entries are sorted by key
+    key_type key(std::size_t i) const;
+    view_t<V> value(std::size_t i) const;
+
+    // binary search
+    std::optional<view_t<V>> find(const key_type& key) const;
+    // throws std::runtime_error if there's no such key
+    view_t<V> at(const key_type& key) const;
+
+private:
+    Data entries;
+    std::uint64_t offset;
+    std::size_t count;
+};
+
+}
+
+#include "Snapshot.inl"
@@ -0,0 +1,553 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+namespace Snapshot
+{
+
+namespace detail
+{
+
+template <typename T>
+struct dependent_false : std::false_type { };
+
+constexpr std::uint64_t alignUp(std::uint64_t value, std::uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// size and alignment of record of T, see layout in Snapshot.h
+template <typename T, typename = void>
+struct record {
+    static_assert(dependent_false<T>::value, "Type is not supported by snapshots");
+};
+
+template <typename T>
+struct record<T, std::enable_if_t<std::is_arithmetic<T>::value || std::is_enum<T>::value>> {
+    static constexpr std::uint64_t size = sizeof(T);
+    static constexpr std::uint64_t align = alignof(T);
+};
+
+// offset + length or count
+struct reference_record {
+    static constexpr std::uint64_t size = 16;
+    static constexpr std::uint64_t align = 8;
+};
+
+template <typename Traits, typename Alloc>
+struct record<std::basic_string<char, Traits, Alloc>> : reference_record { };
+
+template <typename T, typename A>
+struct record<std::vector<T, A>> : reference_record { };
+
+template <typename K, typename V, typename H, typename E, typename A>
+struct record<std::unordered_map<K, V, H, E, A>> : reference_record { };
+
+// positions of records of Ts placed one after another, the last one is the end of the last record
+template <typename... Ts>
+constexpr std::array<std::uint64_t, sizeof...(Ts) + 1> recordPositions()
+{
+    constexpr std::uint64_t sizes[] = { record<Ts>::size..., 0 };
+    constexpr std::uint64_t aligns[] = { record<Ts>::align..., 1 };
+    std::array<std::uint64_t, sizeof...(Ts) + 1> positions{};
+    std::uint64_t position = 0;
+    for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+        position = alignUp(position, aligns[i]);
+        positions[i] = position;
+        position += sizes[i];
+    }
+    positions[sizeof...(Ts)] = position;
+    return positions;
+}
+
+template <typename TupleType>
+struct class_record;
+
+template <typename... Members>
+struct class_record<std::tuple<Members...>> {
+    static constexpr auto positions = recordPositions<meta::get_member_type<Members>...>();
+    static constexpr std::uint64_t align = std::max({ std::uint64_t(1), record<meta::get_member_type<Members>>::align... });
+    static constexpr std::uint64_t size = alignUp(positions[sizeof...(Members)], align);
+};
+
+template <typename T>
+struct record<T, std::enable_if_t<meta::isRegistered<T>()>> :
+    class_record<std::decay_t<decltype(meta::registerMembers<T>())>> { };
+
+// map entry is key record followed by value record
+template <typename K, typename V>
+struct entry_record {
+    static constexpr auto positions = recordPositions<K, V>();
+    static constexpr std::uint64_t align = std::max(record<K>::align, record<V>::align);
+    static constexpr std::uint64_t size = alignUp(positions[2], align);
+};
+
+// the biggest alignment of records of T and of everything T refers to. Numbers may have different
+// alignment on different hosts (e.g. double on 32-bit x86), schemaHash doesn't cover it
+template <typename T, typename = void>
+struct max_align : std::integral_constant<std::uint64_t, record<T>::align> { };
+
+template <typename Traits, typename Alloc>
+struct max_align<std::basic_string<char, Traits, Alloc>> :
+    std::integral_constant<std::uint64_t, reference_record::align> { };
+
+template <typename T, typename A>
+struct max_align<std::vector<T, A>> :
+    std::integral_constant<std::uint64_t, std::max(reference_record::align, max_align<T>::value)> { };
+
+template <typename K, typename V, typename H, typename E, typename A>
+struct max_align<std::unordered_map<K, V, H, E, A>> : std::integral_constant<std::uint64_t,
+    std::max({ reference_record::align, max_align<K>::value, max_align<V>::value })> { };
+
+template <typename TupleType>
+struct class_max_align;
+
+template <typename... Members>
+struct class_max_align<std::tuple<Members...>> : std::integral_constant<std::uint64_t,
+    std::max({ std::uint64_t(1), max_align<meta::get_member_type<Members>>::value... })> { };
+
+template <typename T>
+struct max_align<T, std::enable_if_t<meta::isRegistered<T>()>> :
+    class_max_align<std::decay_t<decltype(meta::registerMembers<T>())>> { };
+
+template <typename T>
+constexpr bool is_raw_array_element = std::is_arithmetic<T>::value && !std::is_same<T, bool>::value;
+
+// Appends variable size data to snapshot, everything is addressed by offsets because buffer grows
+class Writer {
+public:
+    explicit Writer(std::string& out) : out(out) { }
+
+    // reserves zeroed space, returns its offset
+    std::uint64_t allocate(std::uint64_t size, std::uint64_t align)
+    {
+        const std::uint64_t offset = alignUp(out.size(), align);
+        out.resize(offset + size);
+        return offset;
+    }
+
+    void put(std::uint64_t at, const void* data, std::size_t size)
+    {
+        if (size != 0) {
+            std::memcpy(&out[at], data, size);
+        }
+    }
+
+    void putReference(std::uint64_t at, std::uint64_t offset, std::uint64_t count)
+    {
+        const std::uint64_t reference[2] = { offset, count };
+        put(at, reference, sizeof(reference));
+    }
+private:
+    std::string& out;
+};
+
+constexpr std::uint64_t headerSize = 40;
+
+void writeHeader(std::string& out, std::uint64_t schemaHash, std::uint64_t maxAlign, std::uint64_t root);
+// checks header and returns offset of root object
+std::uint64_t readHeader(std::string_view data, std::uint64_t schemaHash, std::uint64_t maxAlign);
+void writeBytesToFile(const std::string& path, std::string_view bytes);
+
+// {offset, count} stored at 'at'
+std::pair<std::uint64_t, std::uint64_t> readReference(const Data& data, std::uint64_t at);
+
+/////////////////// WRITING
+
+template <typename T>
+void writeAt(Writer& writer, std::uint64_t at, const T& obj);
+
+template <typename Traits, typename Alloc>
+void writeAt(Writer& writer, std::uint64_t at, const std::basic_string<char, Traits, Alloc>& obj);
+
+template <typename T, typename A>
+void writeAt(Writer& writer, std::uint64_t at, const std::vector<T, A>& obj);
+
+template <typename K, typename V, typename H, typename E, typename A>
+void writeAt(Writer& writer, std::uint64_t at, const std::unordered_map<K, V, H, E, A>& obj);
+
+template <typename Class, std::size_t... I>
+void writeMembers(Writer& writer, std::uint64_t at, const Class& obj, std::index_sequence<I...>)
+{
+    using Record = record<Class>;
+    const auto& members = meta::getMembers<Class>();
+    (meta::detail::for_each_arg(
+        [&writer, &obj, position = at + Record::positions[I]](const auto& member)
+        {
+            using MemberInfo = std::decay_t<decltype(member)>;
+            if constexpr (MemberInfo::canGetConstRef()) {
+                writeAt(writer, position, member.get(obj));
+            } else {
+                writeAt(writer, position, member.getCopy(obj));
+            }
+        },
+        std::get<I>(members)), ...);
+}
+
+template <typename T>
+void writeAt(Writer& writer, std::uint64_t at, const T& obj)
+{
+    if constexpr (meta::isRegistered<T>()) {
+        writeMembers(writer, at, obj, std::make_index_sequence<meta::getMemberCount<T>()>());
+    } else {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Type is not supported by snapshots");
+        writer.put(at, &obj, sizeof(T));
+    }
+}
+
+template <typename Traits, typename Alloc>
+void writeAt(Writer& writer, std::uint64_t at, const std::basic_string<char, Traits, Alloc>& obj)
+{
+    const auto offset = writer.allocate(obj.size(), 1);
+    writer.put(offset, obj.data(), obj.size());
+    writer.putReference(at, offset, obj.size());
+}
+
+template <typename T, typename A>
+void writeAt(Writer& writer, std::uint64_t at, const std::vector<T, A>& obj)
+{
+    const std::uint64_t size = record<T>::size;
+    const auto offset = writer.allocate(obj.size() * size, record<T>::align);
+    writer.putReference(at, offset, obj.size());
+    if constexpr (is_raw_array_element<T>) {
+        writer.put(offset, obj.data(), obj.size() * sizeof(T)); // records are values themselves
+    } else {
+        for (std::size_t i = 0; i < obj.size(); ++i) {
+            writeAt(writer, offset + i * size, static_cast<const T&>(obj[i]));
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void writeAt(Writer& writer, std::uint64_t at, const std::unordered_map<K, V, H, E, A>& obj)
+{
+    using Entry = entry_record<K, V>;
+    std::vector<const typename std::unordered_map<K, V, H, E, A>::value_type*> sorted;
+    sorted.reserve(obj.size());
+    for (const auto& entry : obj) {
+        sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    const auto offset = writer.allocate(obj.size() * Entry::size, Entry::align);
+    writer.putReference(at, offset, obj.size());
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        writeAt(writer, offset + i * Entry::size + Entry::positions[0], sorted[i]->first);
+        writeAt(writer, offset + i * Entry::size + Entry::positions[1], sorted[i]->second);
+    }
+}
+
+/////////////////// READING
+
+template <typename T>
+view_t<T> viewAt(const Data& data, std::uint64_t at, const T*)
+{
+    if constexpr (meta::isRegistered<T>()) {
+        return ObjectView<T>(data, at);
+    } else if constexpr (std::is_same<T, bool>::value) {
+        return *data.at(at, 1) != 0;
+    } else {
+        T value;
+        std::memcpy(&value, data.at(at, sizeof(T)), sizeof(T));
+        return value;
+    }
+}
+
+template <typename Traits, typename Alloc>
+std::string_view viewAt(const Data& data, std::uint64_t at, const std::basic_string<char, Traits, Alloc>*)
+{
+    const auto reference = readReference(data, at);
+    return std::string_view(data.at(reference.first, reference.second), reference.second);
+}
+
+template <typename T, typename A>
+ArrayView<T> viewAt(const Data& data, std::uint64_t at, const std::vector<T, A>*)
+{
+    const auto reference = readReference(data, at);
+    return ArrayView<T>(data, reference.first, reference.second);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+MapView<K, V> viewAt(const Data& data, std::uint64_t at, const std::unordered_map<K, V, H, E, A>*)
+{
+    const auto reference = readReference(data, at);
+    return MapView<K, V>(data, reference.first, reference.second);
+}
+
+template <typename T>
+view_t<T> viewOf(const Data& data, std::uint64_t at)
+{
+    return viewAt(data, at, static_cast<const T*>(nullptr));
+}
+
+/////////////////// LOADING
+
+template <typename T>
+void loadAt(const Data& data, std::uint64_t at, T& obj);
+
+template <typename Traits, typename Alloc>
+void loadAt(const Data& data, std::uint64_t at, std::basic_string<char, Traits, Alloc>& obj);
+
+template <typename T, typename A>
+void loadAt(const Data& data, std::uint64_t at, std::vector<T, A>& obj);
+
+template <typename K, typename V, typename H, typename E, typename A>
+void loadAt(const Data& data, std::uint64_t at, std::unordered_map<K, V, H, E, A>& obj);
+
+template <typename Class, std::size_t... I>
+void loadMembers(const Data& data, std::uint64_t at, Class& obj, std::index_sequence<I...>)
+{
+    using Record = record<Class>;
+    const auto& members = meta::getMembers<Class>();
+    (meta::detail::for_each_arg(
+        [&data, &obj, position = at + Record::positions[I]](const auto& member)
+        {
+            using MemberT = meta::get_member_type<decltype(member)>;
+            if (member.canGetRef()) { // always true for data members
+                loadAt(data, position, member.getRef(obj));
+            } else if constexpr (std::is_default_constructible<MemberT>::value) {
+                MemberT value{};
+                loadAt(data, position, value);
+                member.set(obj, std::move(value));
+            } else {
+                throw std::runtime_error("Error: can't load member: it has no non-const getter and its type is not default constructible");
+            }
+        },
+        std::get<I>(members)), ...);
+}
+
+template <typename T>
+void loadAt(const Data& data, std::uint64_t at, T& obj)
+{
+    if constexpr (meta::isRegistered<T>()) {
+        loadMembers(data, at, obj, std::make_index_sequence<meta::getMemberCount<T>()>());
+    } else {
+        obj = viewOf<T>(data, at);
+    }
+}
+
+template <typename Traits, typename Alloc>
+void loadAt(const Data& data, std::uint64_t at, std::basic_string<char, Traits, Alloc>& obj)
+{
+    const auto str = viewOf<std::string>(data, at);
+    obj.assign(str.data(), str.size());
+}
+
+template <typename T, typename A>
+void loadAt(const Data& data, std::uint64_t at, std::vector<T, A>& obj)
+{
+    const auto reference = readReference(data, at);
+    const ArrayView<T> items(data, reference.first, reference.second); // checks bounds
+    obj.resize(items.size());
+    if constexpr (is_raw_array_element<T>) {
+        if (!obj.empty()) {
+            std::memcpy(obj.data(), items.data(), obj.size() * sizeof(T));
+        }
+    } else {
+        for (std::size_t i = 0; i < obj.size(); ++i) {
+            if constexpr (std::is_same<T, bool>::value) {
+                obj[i] = items[i];
+            } else {
+                loadAt(data, reference.first + i * record<T>::size, obj[i]);
+            }
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void loadAt(const Data& data, std::uint64_t at, std::unordered_map<K, V, H, E, A>& obj)
+{
+    using Entry = entry_record<K, V>;
+    const auto reference = readReference(data, at);
+    const MapView<K, V> entries(data, reference.first, reference.second); // checks bounds
+    obj.clear();
+    obj.reserve(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        K key{};
+        loadAt(data, reference.first + i * Entry::size + Entry::positions[0], key);
+        auto& value = obj.try_emplace(std::move(key)).first->second;
+        loadAt(data, reference.first + i * Entry::size + Entry::positions[1], value);
+    }
+}
+
+} // end of namespace detail
+
+/////////////////// ENTRY POINTS
+
+template <typename Class>
+std::string write(const Class& obj)
+{
+    static_assert(meta::isRegistered<Class>(), "Class is not registered");
+    std::string out(detail::headerSize, '\0');
+    detail::Writer writer(out);
+    const auto root = writer.allocate(detail::record<Class>::size, detail::record<Class>::align);
+    detail::writeAt(writer, root, obj);
+    detail::writeHeader(out, meta::schemaHash<Class>(), detail::max_align<Class>::value, root);
+    return out;
+}
+
+template <typename Class>
+void writeFile(const std::string& path, const Class& obj)
+{
+    detail::writeBytesToFile(path, write(obj));
+}
+
+template <typename Class>
+ObjectView<Class> open(std::string_view data)
+{
+    const auto root = detail::readHeader(data, meta::schemaHash<Class>(), detail::max_align<Class>::value);
+    return ObjectView<Class>(Data(data), root);
+}
+
+template <typename Class>
+Class load(std::string_view data)
+{
+    return open<Class>(data).load();
+}
+
+/////////////////// VIEWS
+
+template <typename Class>
+ObjectView<Class>::ObjectView(const Data& data, std::uint64_t offset) :
+    data(data), offset(offset)
+{
+    data.at(offset, detail::record<Class>::size); // members at fixed positions are inside of data
+}
+
+template <typename Class>
+template <std::size_t I>
+auto ObjectView<Class>::get() const
+{
+    using MemberT = meta::get_member_type<std::tuple_element_t<I, std::decay_t<decltype(meta::getMembers<Class>())>>>;
+    return detail::viewOf<MemberT>(data, offset + detail::record<Class>::positions[I]);
+}
+
+template <typename Class>
+template <typename T>
+view_t<T> ObjectView<Class>::get(std::string_view name) const
+{
+    const auto index = meta::memberIndex<Class>(name);
+    if (index == meta::npos) {
+        throw std::runtime_error("Error: class has no member '" + std::string(name) + "'");
+    }
+    auto value = find<T>(index, std::make_index_sequence<meta::getMemberCount<Class>()>());
+    if (!value) {
+        throw std::runtime_error("Error: member '" + std::string(name) + "' doesn't have requested type");
+    }
+    return std::move(*value);
+}
+
+template <typename Class>
+template <typename T, std::size_t... I>
+std::optional<view_t<T>> ObjectView<Class>::find(std::size_t index, std::index_sequence<I...>) const
+{
+    std::optional<view_t<T>> value;
+    ((I == index ? getIfSame<T, I>(value) : void()), ...);
+    return value;
+}
+
+template <typename Class>
+template <typename T, std::size_t I>
+void ObjectView<Class>::getIfSame(std::optional<view_t<T>>& result) const
+{
+    using MemberT = meta::get_member_type<std::tuple_element_t<I, std::decay_t<decltype(meta::getMembers<Class>())>>>;
+    if constexpr (std::is_same<MemberT, T>::value) {
+        result.emplace(get<I>());
+    }
+}
+
+template <typename Class>
+Class ObjectView<Class>::load() const
+{
+    Class obj;
+    load(obj);
+    return obj;
+}
+
+template <typename Class>
+void ObjectView<Class>::load(Class& obj) const
+{
+    detail::loadAt(data, offset, obj);
+}
+
+template <typename T>
+ArrayView<T>::ArrayView(const Data& data, std::uint64_t offset, std::uint64_t count) :
+    items(data), offset(offset), count(static_cast<std::size_t>(count))
+{
+    if (count > data.size() / detail::record<T>::size) {
+        throw std::runtime_error("Error: snapshot is corrupted, array is bigger than snapshot");
+    }
+    data.at(offset, count * detail::record<T>::size);
+}
+
+template <typename T>
+view_t<T> ArrayView<T>::operator[](std::size_t i) const
+{
+    if (i >= count) {
+        throw std::runtime_error("Error: snapshot array index is out of range");
+    }
+    return detail::viewOf<T>(items, offset + i * detail::record<T>::size);
+}
+
+template <typename K, typename V>
+MapView<K, V>::MapView(const Data& data, std::uint64_t offset, std::uint64_t count) :
+    entries(data), offset(offset), count(static_cast<std::size_t>(count))
+{
+    if (count > data.size() / detail::entry_record<K, V>::size) {
+        throw std::runtime_error("Error: snapshot is corrupted, map is bigger than snapshot");
+    }
+    data.at(offset, count * detail::entry_record<K, V>::size);
+}
+
+template <typename K, typename V>
+typename MapView<K, V>::key_type MapView<K, V>::key(std::size_t i) const
+{
+    using Entry = detail::entry_record<K, V>;
+    if (i >= count) {
+        throw std::runtime_error("Error: snapshot map index is out of range");
+    }
+    return detail::viewOf<K>(entries, offset + i * Entry::size + Entry::positions[0]);
+}
+
+template <typename K, typename V>
+view_t<V> MapView<K, V>::value(std::size_t i) const
+{
+    using Entry = detail::entry_record<K, V>;
+    if (i >= count) {
+        throw std::runtime_error("Error: snapshot map index is out of range");
+    }
+    return detail::viewOf<V>(entries, offset + i * Entry::size + Entry::positions[1]);
+}
+
+template <typename K, typename V>
+std::optional<view_t<V>> MapView<K, V>::find(const key_type& key) const
+{
+    std::size_t first = 0;
+    std::size_t last = count;
+    while (first < last) {
+        const std::size_t middle = first + (last - first) / 2;
+        const key_type middleKey = this->key(middle);
+        if (middleKey < key) {
+            first = middle + 1;
+        } else if (key < middleKey) {
+            last = middle;
+        } else {
+            return value(middle);
+        }
+    }
+    return std::nullopt;
+}
+
+template <typename K, typename V>
+view_t<V> MapView<K, V>::at(const key_type& key) const
+{
+    auto found = find(key);
+    if (!found) {
+        throw std::runtime_error("Error: snapshot map has no such key");
+    }
+    return std::move(*found);
+}
+
+}
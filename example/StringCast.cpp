@@ -1,4 +1,4 @@
-#include "stringcast.h"
+#include "StringCast.h"
 
 std::string castToString(const bool& value)
 {
@@ -7,45 +7,17 @@ std::string castToString(const bool& value)
 
 std::string castToString(const int& value)
 {
-    return std::to_string(value);
+    char buffer[maxCastLength];
+    return std::string(buffer, castToChars(buffer, buffer + maxCastLength, value));
 }
 
 std::string castToString(const float& value)
 {
-    return std::to_string(value);
+    char buffer[maxCastLength];
+    return std::string(buffer, castToChars(buffer, buffer + maxCastLength, value));
 }
 
 std::string castToString(const std::string& value)
 {
     return value;
 }
-
-// from string
-
-template <>
-bool fromString(const std::string& valueStr)
-{
-    if (valueStr == "true") {
-        return true;
-    } else if (valueStr == "false") {
-        return false;
-    }
-}
-
-template <>
-int fromString(const std::string& valueStr)
-{
-    return std::stoi(valueStr);
-}
-
-template <>
-float fromString(const std::string& valueStr)
-{
-    return std::stof(valueStr);
-}
-
-template <>
-std::string fromString(const std::string& valueStr)
-{
-    return valueStr;
-}
\ No newline at end of file
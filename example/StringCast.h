@@ -1,7 +1,31 @@
 // In JSON map keys can only be strings, so here's a class which makes conversion to/from string easy
+// Numbers are converted with std::to_chars/std::from_chars: conversions don't allocate, don't depend
+// on locale and floating point numbers are written in the shortest form which is parsed back to the same value
 #pragma once
 
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// std::string and strings with other allocators (e.g. std::pmr::string)
+template <typename T>
+struct is_basic_string : std::false_type { };
+
+template <typename Traits, typename Alloc>
+struct is_basic_string<std::basic_string<char, Traits, Alloc>> : std::true_type { };
+
+// Enough for any bool or number written by castToChars
+constexpr std::size_t maxCastLength = 32;
+
+// Writes value to [first, last) and returns pointer past the last written char
+// or nullptr if the buffer is too small. Writes nothing if no conversion possible
+template <typename T>
+char* castToChars(char* first, char* last, const T& value);
 
 template <typename T>
 std::string castToString(const T& value);
@@ -13,31 +37,88 @@ std::string castToString(const int& value);
 std::string castToString(const float& value);
 std::string castToString(const std::string& value);
 
+// Whole string should be a valid value: bools are "true" or "false", numbers are in castToChars format.
+// Throws std::invalid_argument or std::out_of_range (like std::stoi does) when it's not
 template <typename T>
-T fromString(const std::string& value);
-
-template <>
-bool fromString(const std::string& valueStr);
-
-template <>
-int fromString(const std::string& valueStr);
+T fromString(std::string_view value);
 
-template <>
-float fromString(const std::string& valueStr);
+// the same, but strings are constructed with alloc (e.g. allocator of container they're inserted to)
+template <typename T, typename Alloc>
+T fromString(std::string_view value, const Alloc& alloc);
 
-template <>
-std::string fromString(const std::string& valueStr);
 
+template <typename T>
+char* castToChars(char* first, char* last, const T& value)
+{
+    if constexpr (std::is_same<T, bool>::value) {
+        const std::string_view str = value ? "true" : "false";
+        if (static_cast<std::size_t>(last - first) < str.size()) {
+            return nullptr;
+        }
+        std::memcpy(first, str.data(), str.size());
+        return first + str.size();
+    } else if constexpr (std::is_arithmetic<T>::value) {
+        const auto result = std::to_chars(first, last, value); // shortest round trip form for floats
+        return result.ec == std::errc() ? result.ptr : nullptr;
+    } else if constexpr (is_basic_string<T>::value) {
+        if (static_cast<std::size_t>(last - first) < value.size()) {
+            return nullptr;
+        }
+        std::memcpy(first, value.data(), value.size());
+        return first + value.size();
+    } else {
+        return first;
+    }
+}
 
 // return empty string if no conversion possible
 template <typename T>
-std::string castToString(const T& /* value */)
+std::string castToString(const T& value)
 {
-    return std::string();
+    if constexpr (std::is_arithmetic<T>::value) {
+        char buffer[maxCastLength];
+        return std::string(buffer, castToChars(buffer, buffer + maxCastLength, value));
+    } else if constexpr (is_basic_string<T>::value) {
+        return std::string(value.data(), value.size());
+    } else {
+        return std::string();
+    }
 }
 
 template <typename T>
-T fromString(const std::string& /* value */)
+T fromString(std::string_view value)
 {
-    return T;
-}
\ No newline at end of file
+    if constexpr (std::is_same<T, bool>::value) {
+        if (value == "true") {
+            return true;
+        } else if (value == "false") {
+            return false;
+        }
+        throw std::invalid_argument("Error: can't convert string to bool");
+    } else if constexpr (std::is_arithmetic<T>::value) {
+        T result{};
+        const auto last = value.data() + value.size();
+        const auto parsed = std::from_chars(value.data(), last, result);
+        if (parsed.ec == std::errc::result_out_of_range) {
+            throw std::out_of_range("Error: number is out of range");
+        }
+        if (parsed.ec != std::errc() || parsed.ptr != last) {
+            throw std::invalid_argument("Error: can't convert string to number");
+        }
+        return result;
+    } else if constexpr (std::is_constructible<T, std::string_view>::value) {
+        return T(value);
+    } else {
+        return T();
+    }
+}
+
+template <typename T, typename Alloc>
+T fromString(std::string_view value, const Alloc& alloc)
+{
+    if constexpr (is_basic_string<T>::value) {
+        return T(value.data(), value.size(), typename T::allocator_type(alloc));
+    } else {
+        return fromString<T>(value);
+    }
+}
@@ -0,0 +1,81 @@
+#include "ThreadPool.h"
+
+namespace
+{
+
+thread_local ThreadPool* currentPool = nullptr;
+
+} // end of anonymous namespace
+
+ThreadPool::ThreadPool(unsigned threadCount, std::size_t threshold) :
+    stopping(false),
+    threshold(threshold)
+{
+    // calling thread works too, so one thread less is needed
+    const unsigned workers = threadCount > 1 ? threadCount - 1 : 0;
+    threads.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        threads.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAdded.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::post(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    taskAdded.notify_one();
+}
+
+void ThreadPool::workerLoop()
+{
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAdded.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return; // stopping
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+ThreadPool* ThreadPool::current()
+{
+    return currentPool;
+}
+
+ThreadPool* ThreadPool::exchangeCurrent(ThreadPool* pool)
+{
+    ThreadPool* const previous = currentPool;
+    currentPool = pool;
+    return previous;
+}
+
+ThreadPool::Scope::Scope(ThreadPool& pool) :
+    previous(currentPool)
+{
+    currentPool = &pool;
+}
+
+ThreadPool::Scope::~Scope()
+{
+    currentPool = previous;
+}
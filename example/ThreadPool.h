@@ -0,0 +1,85 @@
+// Thread pool used by serializers to encode large containers in parallel.
+//
+// Parallel mode is opt-in and is enabled per thread with ThreadPool::Scope:
+//
+//     ThreadPool pool;
+//     {
+//         ThreadPool::Scope parallel(pool);
+//         auto value = Json::serialize(person); // or Json::write, Binary::serialize
+//     }
+//
+// While scope is active, std::vector and std::unordered_map with at least getThreshold() elements
+// are split into chunks, each chunk is encoded into its own buffer on pool threads and chunks are
+// concatenated in order, so output is the same as in serial mode.
+// Containers nested inside a chunk are encoded serially, on the calling thread too. Getters of
+// registered members can be called from pool threads, so they must be safe to call concurrently.
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    // threshold is the minimal number of container elements which are worth encoding in parallel
+    explicit ThreadPool(unsigned threadCount = std::thread::hardware_concurrency(),
+        std::size_t threshold = 4096);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned getThreadCount() const { return static_cast<unsigned>(threads.size()) + 1; } // with calling thread
+    std::size_t getThreshold() const { return threshold; }
+
+    // Calls f(i) for each i in [0, count) on pool threads and calling thread and waits for all calls.
+    // The first exception thrown by f is rethrown
+    template <typename F>
+    void parallelFor(std::size_t count, F&& f);
+
+    // Splits [0, count) into ranges and calls encode(chunk, begin, end) for them in parallel,
+    // each range gets its own default constructed Chunk.
+    // Then calls merge(chunk) for each range in order on calling thread
+    template <typename Chunk, typename Encode, typename Merge>
+    void encodeChunked(std::size_t count, Encode&& encode, Merge&& merge);
+
+    // Pool which serializers use on this thread or nullptr if parallel mode isn't enabled.
+    // It's always nullptr on pool threads
+    static ThreadPool* current();
+    // current() if container of count elements is big enough to be encoded in parallel, nullptr otherwise
+    static ThreadPool* currentFor(std::size_t count);
+
+    // Enables parallel mode on this thread until destroyed
+    class Scope {
+    public:
+        explicit Scope(ThreadPool& pool);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        ThreadPool* previous;
+    };
+
+private:
+    // sets current() of this thread, returns the previous one
+    static ThreadPool* exchangeCurrent(ThreadPool* pool);
+
+    void post(std::function<void()> task);
+    void workerLoop();
+
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAdded;
+    bool stopping;
+    std::size_t threshold;
+};
+
+#include "ThreadPool.inl"
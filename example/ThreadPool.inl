@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+inline ThreadPool* ThreadPool::currentFor(std::size_t count)
+{
+    ThreadPool* pool = current();
+    return pool && count >= pool->threshold ? pool : nullptr;
+}
+
+template <typename F>
+void ThreadPool::parallelFor(std::size_t count, F&& f)
+{
+    if (count == 0) {
+        return;
+    }
+    // shared with helper tasks: helpers which start after all indices are taken just exit,
+    // so parallelFor doesn't wait for them and f is never called after it returns
+    struct State {
+        explicit State(F& f) : f(f) { }
+
+        F& f;
+        std::atomic<std::size_t> next{ 0 };
+        std::size_t done = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<State>(f);
+    const std::size_t total = count;
+    auto work = [state, total]()
+    {
+        for (std::size_t i = state->next++; i < total; i = state->next++) {
+            std::exception_ptr error;
+            try {
+                state->f(i);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (error && !state->error) {
+                state->error = error;
+            }
+            if (++state->done == total) {
+                state->finished.notify_one();
+            }
+        }
+    };
+
+    const std::size_t helpers = std::min<std::size_t>(threads.size(), count - 1);
+    for (std::size_t i = 0; i < helpers; ++i) {
+        post(work);
+    }
+    // calling thread takes its share like pool threads do, without parallel mode
+    ThreadPool* const previous = exchangeCurrent(nullptr);
+    work();
+    exchangeCurrent(previous);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state, total]() { return state->done == total; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+template <typename Chunk, typename Encode, typename Merge>
+void ThreadPool::encodeChunked(std::size_t count, Encode&& encode, Merge&& merge)
+{
+    // a few chunks per thread, so threads which finish early can take more work
+    const std::size_t chunkCount = std::max<std::size_t>(1, std::min<std::size_t>(count, 4 * (threads.size() + 1)));
+    const std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    std::vector<Chunk> chunks(chunkCount);
+    parallelFor(chunkCount,
+        [&chunks, &encode, count, chunkSize](std::size_t i)
+        {
+            const std::size_t begin = std::min(count, i * chunkSize);
+            const std::size_t end = std::min(count, begin + chunkSize);
+            encode(chunks[i], begin, end);
+        }
+    );
+    for (auto& chunk : chunks) {
+        merge(chunk);
+    }
+}
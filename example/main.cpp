@@ -1,15 +1,65 @@
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <json/json.h>
 
+#include "BinaryCast.h"
+#include "BinaryPatch.h"
 #include "JsonCast.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
 #include "Person.h"
+#include "Snapshot.h"
 
 class Unregistered
 { };
 
 #include <Meta.h>
 
+// has no default constructor, deserializers call Review(movie, stars)
+class Review
+{
+public:
+    Review(std::string movie, int stars) : movie(std::move(movie)), stars(stars) { }
+
+    std::string movie;
+    int stars;
+};
+
+struct Shelf {
+    std::vector<Review> reviews;
+};
+
+namespace meta
+{
+
+template <>
+constexpr auto registerMembers<Review>()
+{
+    return members(
+        member("movie", &Review::movie),
+        member("stars", &Review::stars)
+    );
+}
+
+template <>
+struct constructor_args<Review> {
+    using types = type_list<std::string, int>;
+    static constexpr const char* members[] = { "movie", "stars" };
+};
+
+template <>
+constexpr auto registerMembers<Shelf>()
+{
+    return members(
+        member("reviews", &Shelf::reviews)
+    );
+}
+
+}
+
 void printSeparator()
 {
     std::cout << "========================\n";
@@ -79,6 +129,11 @@ int main()
     Json::Value root = Json::serialize(person);
     std::cout << root << std::endl;
 
+    // the same JSON can be written without building Json::Value first
+    std::cout << "Writing person as compact JSON:\n";
+    Json::write(std::cout, person);
+    std::cout << '\n';
+
     Unregistered y;
     Json::Value root2 = Json::serialize(y);
     std::cout << "Trying to serialize unregistered class:\n";
@@ -91,7 +146,62 @@ int main()
     auto person2 = Json::deserialize<Person>(root);
     std::cout << "Person 2 name is " << person2.getName() << " too!" << '\n';
 
+    printSeparator();
+
+    std::cout << "Deserializing into existing Person 2 in place:\n";
+    // members are deserialized by reference when possible, strings and containers keep their storage
+    Json::deserialize(person2, root, Json::inPlace);
+    std::cout << "Person 2 has " << person2.favouriteMovies.size() << " favourite movie lists\n";
+
+    printSeparator();
+
+    std::cout << "Reading Person 3 from JSON text without Json::Value:\n";
+    auto person3 = Json::read<Person>(Json::writeToString(person));
+    std::cout << "Person 3 has salary " << person3.salary << '\n';
+
+    printSeparator();
+
+    std::cout << "Serializing person to binary:\n";
+    const auto bytes = Binary::serialize(person);
+    const auto jsonSize = Json::writeToString(person).size();
+    std::cout << "Binary form takes " << bytes.size() << " bytes, JSON takes " << jsonSize << '\n';
+    auto person4 = Binary::deserialize<Person>(bytes);
+    std::cout << "Person 4 name is " << person4.getName() << '\n';
+
+    printSeparator();
+
+    std::cout << "Making patch with changed salary:\n";
+    auto person5 = person4;
+    person5.salary += 100.f;
+    const auto patch = Binary::makePatch(person4, person5);
+    Binary::applyPatch(person4, patch);
+    std::cout << "Patch takes " << patch.size() << " bytes, Person 4 has salary " << person4.salary << " now\n";
+
+    printSeparator();
+
+    std::cout << "Reading class without default constructor:\n";
+    const auto shelf = Json::read<Shelf>(R"({"reviews":[{"movie":"The Room","stars":1},{"stars":5,"movie":"Goosebumps"}]})");
+    const auto shelf2 = Binary::deserialize<Shelf>(Binary::serialize(shelf));
+    std::cout << "Review of " << shelf2.reviews[1].movie << " has " << shelf2.reviews[1].stars << " stars\n";
+
+    printSeparator();
+
+    std::cout << "Writing person to snapshot and reading it in place:\n";
+    const auto snapshot = Snapshot::write(person);
+    const auto view = Snapshot::open<Person>(snapshot);
+    const auto movies = view.get<std::unordered_map<std::string, std::vector<MovieInfo>>>("favouriteMovies");
+    std::cout << view.get<std::string>("name") << " gives " << movies.at("John Tron")[1].get<float>("rating")
+              << " to " << movies.at("John Tron")[1].get<std::string>("name") << '\n';
+    const auto person6 = Snapshot::load<Person>(snapshot);
+    std::cout << "Person 6 has " << person6.favouriteMovies.size() << " favourite movie lists\n";
+    try { // strings and arrays of truncated snapshot point outside of it
+        const auto truncated = snapshot.substr(0, snapshot.size() / 2);
+        Snapshot::open<Person>(truncated).load();
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << '\n';
+    }
+
 #ifdef _WIN32 // okay, this is not cool code, sorry :D
     system("pause");
 #endif
-}
\ No newline at end of file
+}
\ No newline at end of file
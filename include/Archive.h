@@ -0,0 +1,134 @@
+/* -----------------------------------------------------------------------------------------------
+
+meta::Archive<Derived> is one traversal of registered classes which drives output formats through
+static (CRTP) dispatch. A format derives from it, implements the hooks below and calls save(value):
+
+    class TextArchive : public meta::Archive<TextArchive> {
+    public:
+        std::size_t written() const;                         // bytes so far, for stats (Stats.h)
+
+        template <typename Class>
+        std::size_t beginObject();                           // result is passed to endObject
+        template <typename Class>
+        void key(std::size_t position, std::size_t index);   // before each member value
+        template <typename Class>
+        void endObject(std::size_t state);
+
+        void beginSequence(std::size_t count);               // std::vector
+        void element(std::size_t i);                         // before each element
+        void endSequence();
+
+        void beginMap(std::size_t count);                    // std::unordered_map
+        template <typename K>
+        void mapKey(const K& key, std::size_t i);            // before each value
+        void endMap();
+
+        template <typename T>
+        void scalar(const T& value);                         // everything else: numbers, strings...
+    };
+
+Members are visited in registration order, 'position' is the number of members visited before
+this one and 'index' is the member's index in getMembers<Class>(). A format which writes members
+in another order sets 'static constexpr bool keepsMemberOrder = false' and provides
+'template <typename Class> static const auto& memberOrder()', an array of member indices.
+
+saveObject(obj, projection) visits only members selected by meta::Projection (see Projection.h),
+nested projections are applied to registered classes inside of selected members, containers
+included. Skipped members don't count in 'position'.
+
+Hooks are called on Derived directly, so there are no virtual calls and they're inlined.
+Derived can also hide save, saveObject, saveSequence, saveMap, saveElements and saveEntries to take
+over whole values of some types and call the Archive versions for everything else:
+- saveSequence and saveMap get whole containers, e.g. to write arrays of numbers with one memcpy.
+- saveElements and saveEntries get containers with saveElement(archive, elem) which saves each
+  element (or map value), for whole and projected containers alike. They can run it on other
+  archives of the same format, e.g. to write big containers in parallel chunks.
+
+Only writing goes through archives: readers are driven by the order of their input, they map
+keys to members with memberIndex instead.
+
+-------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "Meta.h"
+#include "Projection.h"
+
+namespace meta
+{
+
+namespace detail
+{
+
+// saveElement of whole containers
+struct save_value {
+    template <typename Archive, typename T>
+    void operator()(Archive& archive, const T& value) const { archive.save(value); }
+};
+
+} // end of namespace detail
+
+template <typename Derived>
+class Archive {
+public:
+    static constexpr bool keepsMemberOrder = true;
+
+    template <typename T>
+    void save(const T& value);
+
+    template <typename T, typename A>
+    void save(const std::vector<T, A>& value);
+
+    template <typename K, typename V, typename H, typename E, typename A>
+    void save(const std::unordered_map<K, V, H, E, A>& value);
+
+    // value is saved whole if projection is nullptr
+    template <typename T, typename C>
+    void saveProjected(const T& value, const Projection<C>* projection);
+
+    template <typename T, typename A, typename C>
+    void saveProjected(const std::vector<T, A>& value, const Projection<C>* projection);
+
+    template <typename K, typename V, typename H, typename E, typename A, typename C>
+    void saveProjected(const std::unordered_map<K, V, H, E, A>& value, const Projection<C>* projection);
+
+    template <typename Class>
+    void saveObject(const Class& obj);
+
+    template <typename Class>
+    void saveObject(const Class& obj, const Projection<Class>& projection);
+
+    template <typename T, typename A>
+    void saveSequence(const std::vector<T, A>& value);
+
+    template <typename K, typename V, typename H, typename E, typename A>
+    void saveMap(const std::unordered_map<K, V, H, E, A>& value);
+
+    template <typename T, typename A, typename SaveElement>
+    void saveElements(const std::vector<T, A>& value, SaveElement&& saveElement);
+
+    template <typename K, typename V, typename H, typename E, typename A, typename SaveElement>
+    void saveEntries(const std::unordered_map<K, V, H, E, A>& value, SaveElement&& saveElement);
+
+protected:
+    Archive() = default;
+
+    Derived& derived() { return static_cast<Derived&>(*this); }
+
+private:
+    // calls saveMember(member, index) for members in the format's order which are selected(index)
+    template <typename Class, typename Selected, typename SaveMember>
+    void saveMembers(Selected&& selected, SaveMember&& saveMember);
+
+    // calls saveValue(value) with value of member
+    template <typename Class, typename MemberType, typename SaveValue>
+    void saveMember(const Class& obj, const MemberType& member, SaveValue&& saveValue);
+};
+
+}
+
+#include "Archive.inl"
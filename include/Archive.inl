@@ -0,0 +1,184 @@
+#include <type_traits>
+
+namespace meta
+{
+
+// Members are declared inline so compilers inline them more eagerly: otherwise traversal of nested
+// objects takes an extra call per level, which is noticeable on deep objects
+
+template <typename Derived>
+template <typename T>
+inline void Archive<Derived>::save(const T& value)
+{
+    if constexpr (isRegistered<T>()) {
+        derived().saveObject(value);
+    } else {
+        derived().scalar(value);
+    }
+}
+
+template <typename Derived>
+template <typename T, typename A>
+inline void Archive<Derived>::save(const std::vector<T, A>& value)
+{
+    derived().saveSequence(value);
+}
+
+template <typename Derived>
+template <typename K, typename V, typename H, typename E, typename A>
+inline void Archive<Derived>::save(const std::unordered_map<K, V, H, E, A>& value)
+{
+    derived().saveMap(value);
+}
+
+template <typename Derived>
+template <typename T, typename C>
+inline void Archive<Derived>::saveProjected(const T& value, const Projection<C>* projection)
+{
+    if constexpr (isRegistered<T>()) {
+        if (projection) {
+            derived().saveObject(value, *projection);
+            return;
+        }
+    }
+    derived().save(value);
+}
+
+template <typename Derived>
+template <typename T, typename A, typename C>
+inline void Archive<Derived>::saveProjected(const std::vector<T, A>& value, const Projection<C>* projection)
+{
+    if (!projection) {
+        derived().save(value);
+        return;
+    }
+    derived().saveElements(value,
+        [projection](auto& archive, const T& elem) { archive.saveProjected(elem, projection); });
+}
+
+template <typename Derived>
+template <typename K, typename V, typename H, typename E, typename A, typename C>
+inline void Archive<Derived>::saveProjected(const std::unordered_map<K, V, H, E, A>& value, const Projection<C>* projection)
+{
+    if (!projection) {
+        derived().save(value);
+        return;
+    }
+    derived().saveEntries(value,
+        [projection](auto& archive, const V& elem) { archive.saveProjected(elem, projection); });
+}
+
+template <typename Derived>
+template <typename Class>
+inline void Archive<Derived>::saveObject(const Class& obj)
+{
+    saveMembers<Class>(
+        [](std::size_t) { return true; },
+        [this, &obj](const auto& member, std::size_t)
+        {
+            saveMember(obj, member, [this](const auto& value) { derived().save(value); });
+        }
+    );
+}
+
+template <typename Derived>
+template <typename Class>
+inline void Archive<Derived>::saveObject(const Class& obj, const Projection<Class>& projection)
+{
+    saveMembers<Class>(
+        [&projection](std::size_t index) { return projection.contains(index); },
+        [this, &obj, &projection](const auto& member, std::size_t index)
+        {
+            using Nested = projected_class_t<get_member_type<decltype(member)>>;
+            const auto* nested = projection.template getNested<Nested>(index);
+            saveMember(obj, member, [this, nested](const auto& value) { derived().saveProjected(value, nested); });
+        }
+    );
+}
+
+template <typename Derived>
+template <typename T, typename A>
+inline void Archive<Derived>::saveSequence(const std::vector<T, A>& value)
+{
+    derived().saveElements(value, detail::save_value());
+}
+
+template <typename Derived>
+template <typename K, typename V, typename H, typename E, typename A>
+inline void Archive<Derived>::saveMap(const std::unordered_map<K, V, H, E, A>& value)
+{
+    derived().saveEntries(value, detail::save_value());
+}
+
+template <typename Derived>
+template <typename T, typename A, typename SaveElement>
+inline void Archive<Derived>::saveElements(const std::vector<T, A>& value, SaveElement&& saveElement)
+{
+    derived().beginSequence(value.size());
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        derived().element(i);
+        saveElement(derived(), static_cast<const T&>(value[i])); // std::vector<bool> elements are proxies
+    }
+    derived().endSequence();
+}
+
+template <typename Derived>
+template <typename K, typename V, typename H, typename E, typename A, typename SaveElement>
+inline void Archive<Derived>::saveEntries(const std::unordered_map<K, V, H, E, A>& value, SaveElement&& saveElement)
+{
+    derived().beginMap(value.size());
+    std::size_t i = 0;
+    for (const auto& pair : value) {
+        derived().mapKey(pair.first, i++);
+        saveElement(derived(), pair.second);
+    }
+    derived().endMap();
+}
+
+template <typename Derived>
+template <typename Class, typename Selected, typename SaveMember>
+inline void Archive<Derived>::saveMembers(Selected&& selected, SaveMember&& saveMember)
+{
+    const auto stats = detail::countScope<Class>(detail::StatsOp::Serialize,
+        [this]() { return derived().written(); });
+    const std::size_t state = derived().template beginObject<Class>();
+    std::size_t position = 0;
+    if constexpr (Derived::keepsMemberOrder) {
+        std::size_t index = 0;
+        doForAllMembers<Class>(
+            [this, &selected, &saveMember, &position, &index](const auto& member)
+            {
+                if (selected(index)) {
+                    derived().template key<Class>(position++, index);
+                    saveMember(member, index);
+                }
+                ++index;
+            }
+        );
+    } else {
+        for (const std::size_t index : Derived::template memberOrder<Class>()) {
+            if (!selected(index)) {
+                continue;
+            }
+            derived().template key<Class>(position++, index);
+            detail::for_tuple_at(index,
+                [&saveMember, index](const auto& member) { saveMember(member, index); },
+                getMembers<Class>()
+            );
+        }
+    }
+    derived().template endObject<Class>(state);
+}
+
+template <typename Derived>
+template <typename Class, typename MemberType, typename SaveValue>
+inline void Archive<Derived>::saveMember(const Class& obj, const MemberType& member, SaveValue&& saveValue)
+{
+    if constexpr (MemberType::canGetConstRef()) {
+        saveValue(member.get(obj));
+    } else {
+        saveValue(member.getCopy(obj));
+    }
+}
+
+}
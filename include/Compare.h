@@ -0,0 +1,78 @@
+/* -----------------------------------------------------------------------------------------------
+
+Equality and hashing of registered classes, generated from their members
+
+meta::equals(a, b) compares registered members in registration order and stops at the first
+difference. meta::hash(obj) combines hashes of the same members, so equal objects have equal
+hashes. Nested registered classes, strings, std::vector and std::unordered_map are handled
+recursively, other members are compared with operator== and hashed with std::hash.
+
+Objects whose bytes are all covered by registered data members and have a single representation
+for each value (integers, enums, no padding, see std::has_unique_object_representations) are
+compared with memcmp and hashed as raw bytes. Vectors of such types are handled as one block.
+
+meta::Hasher<T> and meta::EqualTo<T> let registered classes be used as unordered_map keys:
+
+    std::unordered_map<Key, Value, meta::Hasher<Key>, meta::EqualTo<Key>> cache;
+
+Hashes are fast to compute and well mixed, but they're not cryptographic and they are not
+stable between platforms (they depend on sizes of types).
+
+-------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Meta.h"
+
+namespace meta
+{
+
+template <typename T>
+bool equals(const T& a, const T& b);
+
+template <typename T>
+std::size_t hash(const T& obj);
+
+template <typename T>
+struct Hasher {
+    std::size_t operator()(const T& obj) const { return meta::hash(obj); }
+};
+
+template <typename T>
+struct EqualTo {
+    bool operator()(const T& a, const T& b) const { return meta::equals(a, b); }
+};
+
+namespace detail
+{
+
+// overloads for values of members, used by equals and hash
+template <typename T>
+bool valuesEqual(const T& a, const T& b);
+
+template <typename T, typename A>
+bool valuesEqual(const std::vector<T, A>& a, const std::vector<T, A>& b);
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool valuesEqual(const std::unordered_map<K, V, H, E, A>& a, const std::unordered_map<K, V, H, E, A>& b);
+
+template <typename T>
+std::uint64_t hashValue(const T& obj);
+
+template <typename T, typename A>
+std::uint64_t hashValue(const std::vector<T, A>& obj);
+
+template <typename K, typename V, typename H, typename E, typename A>
+std::uint64_t hashValue(const std::unordered_map<K, V, H, E, A>& obj);
+
+} // end of namespace detail
+
+} // end of namespace meta
+
+#include "Compare.inl"
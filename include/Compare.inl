@@ -0,0 +1,184 @@
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+namespace meta
+{
+
+namespace detail
+{
+
+// murmur3 finalizer
+constexpr std::uint64_t mixHash(std::uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+constexpr std::uint64_t combineHash(std::uint64_t seed, std::uint64_t value)
+{
+    return mixHash(seed + 0x9e3779b97f4a7c15ull + value);
+}
+
+// reads 8 bytes at a time
+inline std::uint64_t hashBytes(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = size;
+    for (; size >= 8; bytes += 8, size -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, 8);
+        hash = combineHash(hash, word);
+    }
+    if (size != 0) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes, size);
+        hash = combineHash(hash, word);
+    }
+    return hash;
+}
+
+// types which can be compared with memcmp and hashed as bytes:
+// registered members cover all bytes and each value has only one representation
+template <typename T>
+constexpr bool isBitwiseComparable()
+{
+    if constexpr (!std::has_unique_object_representations<T>::value) {
+        return false; // floats, padding, bool in some cases
+    } else if constexpr (isRegistered<T>()) {
+        return isTriviallyPacked<T>(); // otherwise not registered members would be compared too
+    } else {
+        return std::is_trivially_copyable<T>::value;
+    }
+}
+
+template <typename T>
+bool valuesEqual(const T& a, const T& b)
+{
+    if constexpr (isBitwiseComparable<T>()) {
+        return std::memcmp(&a, &b, sizeof(T)) == 0;
+    } else if constexpr (isRegistered<T>()) {
+        return !doForAllMembersUntil<T>(
+            [&a, &b](const auto& member)
+            {
+                using MemberInfo = std::decay_t<decltype(member)>;
+                if constexpr (MemberInfo::canGetConstRef()) {
+                    return !valuesEqual(member.get(a), member.get(b));
+                } else {
+                    return !valuesEqual(member.getCopy(a), member.getCopy(b));
+                }
+            }
+        );
+    } else {
+        return a == b;
+    }
+}
+
+template <typename T, typename A>
+bool valuesEqual(const std::vector<T, A>& a, const std::vector<T, A>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    if constexpr (isBitwiseComparable<T>()) {
+        return a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+    } else {
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (!valuesEqual(a[i], b[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool valuesEqual(const std::unordered_map<K, V, H, E, A>& a, const std::unordered_map<K, V, H, E, A>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (const auto& pair : a) {
+        const auto it = b.find(pair.first);
+        if (it == b.end() || !valuesEqual(pair.second, it->second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+std::uint64_t hashValue(const T& obj)
+{
+    if constexpr (isBitwiseComparable<T>()) {
+        return hashBytes(&obj, sizeof(T));
+    } else if constexpr (isRegistered<T>()) {
+        std::uint64_t hash = 0;
+        doForAllMembers<T>(
+            [&obj, &hash](const auto& member)
+            {
+                using MemberInfo = std::decay_t<decltype(member)>;
+                if constexpr (MemberInfo::canGetConstRef()) {
+                    hash = combineHash(hash, hashValue(member.get(obj)));
+                } else {
+                    hash = combineHash(hash, hashValue(member.getCopy(obj)));
+                }
+            }
+        );
+        return hash;
+    } else if constexpr (std::is_floating_point<T>::value) {
+        return obj == 0 ? 0 : hashBytes(&obj, sizeof(T)); // 0.0 == -0.0, so they should have equal hashes
+    } else if constexpr (std::is_same<T, bool>::value) {
+        return mixHash(obj ? 1 : 0);
+    } else if constexpr (std::is_convertible<T, std::string_view>::value) {
+        const std::string_view str = obj;
+        return hashBytes(str.data(), str.size());
+    } else {
+        return mixHash(std::hash<T>{}(obj));
+    }
+}
+
+template <typename T, typename A>
+std::uint64_t hashValue(const std::vector<T, A>& obj)
+{
+    if constexpr (isBitwiseComparable<T>()) {
+        return obj.empty() ? 0 : hashBytes(obj.data(), obj.size() * sizeof(T));
+    } else {
+        std::uint64_t hash = obj.size();
+        for (const auto& elem : obj) {
+            hash = combineHash(hash, hashValue(elem));
+        }
+        return hash;
+    }
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+std::uint64_t hashValue(const std::unordered_map<K, V, H, E, A>& obj)
+{
+    // iteration order of equal maps may differ, so entry hashes are combined with commutative sum
+    std::uint64_t sum = 0;
+    for (const auto& pair : obj) {
+        sum += combineHash(hashValue(pair.first), hashValue(pair.second));
+    }
+    return combineHash(obj.size(), sum);
+}
+
+} // end of namespace detail
+
+template <typename T>
+bool equals(const T& a, const T& b)
+{
+    return detail::valuesEqual(a, b);
+}
+
+template <typename T>
+std::size_t hash(const T& obj)
+{
+    return static_cast<std::size_t>(detail::hashValue(obj));
+}
+
+} // end of namespace meta
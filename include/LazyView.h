@@ -0,0 +1,95 @@
+/* -----------------------------------------------------------------------------------------------
+
+meta::lazy_view<Class, Format> is a read-only view of Class object serialized to a buffer which
+decodes members only when they're accessed. Buffer is scanned once when view is constructed to
+find where encoded member values are, values are decoded on first access and cached:
+
+    Json::LazyView<Person> person(requestBody); // or Binary::LazyView<Person>
+    if (person.get<int>("age") >= 18) { // favouriteMovies are never decoded
+        ...
+    }
+
+Format is a class with two static functions:
+
+    // finds encoded values of members, spans[i] is left empty if member i is not in data
+    template <typename Class, std::size_t N>
+    static void findMembers(std::string_view data, std::array<std::string_view, N>& spans);
+
+    // decodes one value found by findMembers
+    template <typename T>
+    static void decode(std::string_view encoded, T& value);
+
+See Json::LazyFormat (JsonReader.h) and Binary::LazyFormat (BinaryCast.h).
+View doesn't own the buffer. It's not thread safe, even for const access, because of the cache.
+Members which were not in data are default constructed values, so types of members should be
+default constructible.
+
+-------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "Meta.h"
+
+namespace meta
+{
+
+namespace detail
+{
+
+template <typename TupleType>
+struct lazy_cache;
+
+template <typename... Members>
+struct lazy_cache<std::tuple<Members...>> {
+    using type = std::tuple<std::optional<get_member_type<Members>>...>;
+};
+
+} // end of namespace detail
+
+template <typename Class, typename Format>
+class lazy_view {
+    static_assert(isRegistered<Class>(), "Class is not registered");
+public:
+    explicit lazy_view(std::string_view data);
+
+    // Check if member is present in data
+    bool contains(std::string_view name) const;
+
+    // Value of member named 'name', throws std::runtime_error if there's no such member
+    // or it doesn't have type T
+    template <typename T>
+    const T& get(std::string_view name) const;
+
+    // Value of member with index I in getMembers<Class>() tuple
+    template <std::size_t I>
+    const auto& get() const;
+
+private:
+    using cache_type = typename detail::lazy_cache<std::decay_t<decltype(registerMembers<Class>())>>::type;
+
+    // pointer to value of member at index if it has type T, nullptr otherwise
+    template <typename T, std::size_t... I>
+    const T* find(std::size_t index, std::index_sequence<I...>) const;
+    template <typename T, std::size_t I>
+    const T* getIfSame() const;
+
+    std::array<std::string_view, getMemberCount<Class>()> spans;
+    mutable cache_type cache;
+};
+
+// Decodes Class which has registered constructor (see meta::constructor_args) from data in Format:
+// values of constructor arguments are decoded first and passed to constructor (arguments which
+// are not in data are default constructed), then other members are decoded into the new object
+template <typename Class, typename Format>
+Class constructFrom(std::string_view data);
+
+}
+
+#include "LazyView.inl"
@@ -0,0 +1,110 @@
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace meta
+{
+
+template <typename Class, typename Format>
+lazy_view<Class, Format>::lazy_view(std::string_view data)
+{
+    Format::template findMembers<Class>(data, spans);
+}
+
+template <typename Class, typename Format>
+bool lazy_view<Class, Format>::contains(std::string_view name) const
+{
+    const auto index = memberIndex<Class>(name);
+    return index != npos && !spans[index].empty();
+}
+
+template <typename Class, typename Format>
+template <typename T>
+const T& lazy_view<Class, Format>::get(std::string_view name) const
+{
+    const auto index = memberIndex<Class>(name);
+    if (index == npos) {
+        throw std::runtime_error("Error: class has no member '" + std::string(name) + "'");
+    }
+    const T* value = find<T>(index, std::make_index_sequence<getMemberCount<Class>()>());
+    if (!value) {
+        throw std::runtime_error("Error: member '" + std::string(name) + "' doesn't have requested type");
+    }
+    return *value;
+}
+
+template <typename Class, typename Format>
+template <std::size_t I>
+const auto& lazy_view<Class, Format>::get() const
+{
+    auto& cached = std::get<I>(cache);
+    if (!cached) {
+        typename std::decay_t<decltype(cached)>::value_type value{};
+        if (!spans[I].empty()) {
+            Format::decode(spans[I], value);
+        }
+        cached.emplace(std::move(value)); // nothing is cached if decode throws
+    }
+    return *cached;
+}
+
+template <typename Class, typename Format>
+template <typename T, std::size_t... I>
+const T* lazy_view<Class, Format>::find(std::size_t index, std::index_sequence<I...>) const
+{
+    const T* value = nullptr;
+    ((I == index ? void(value = getIfSame<T, I>()) : void()), ...);
+    return value;
+}
+
+template <typename Class, typename Format>
+template <typename T, std::size_t I>
+const T* lazy_view<Class, Format>::getIfSame() const
+{
+    using MemberT = typename std::tuple_element_t<I, cache_type>::value_type;
+    if constexpr (std::is_same<MemberT, T>::value) {
+        return &get<I>();
+    } else {
+        return nullptr;
+    }
+}
+
+template <typename Class, typename Format>
+Class constructFrom(std::string_view data)
+{
+    std::array<std::string_view, getMemberCount<Class>()> spans;
+    Format::template findMembers<Class>(data, spans);
+    Class obj = constructWith<Class>(
+        [&spans](const auto& member)
+        {
+            get_member_type<decltype(member)> value{};
+            const auto span = spans[memberIndex<Class>(member.getNameView())];
+            if (!span.empty()) {
+                Format::decode(span, value);
+            }
+            return value;
+        }
+    );
+    for (std::size_t i = 0; i < spans.size(); ++i) {
+        if (spans[i].empty() || isConstructorArgument<Class>(i)) {
+            continue;
+        }
+        detail::for_tuple_at(i,
+            [&obj, span = spans[i]](const auto& member)
+            {
+                if (member.canGetRef()) {
+                    Format::decode(span, member.getRef(obj));
+                } else {
+                    get_member_type<decltype(member)> value{};
+                    Format::decode(span, value);
+                    member.set(obj, std::move(value));
+                }
+            },
+            getMembers<Class>()
+        );
+    }
+    return obj;
+}
+
+}
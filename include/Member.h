@@ -1,18 +1,28 @@
 /* -----------------------------------------------------------------------------------------------
 
-Member<Class, T> is a representation of a registered member
+Member<Class, T, Kind> is a representation of a registered member
 Class - a class this member belongs to
 T - type of that member
+Kind - how member is accessed (see AccessKind), deduced by meta::member(...)
 
-Member contains pointer to data member which can be used to get / set stuff
-Different getters and setters can be added via fluent interface (see addGetter/addConstGetter/addSetter)
-Getters and setters are always preffered to using raw data member pointers (because why would you
-set them in the other place?)
+Member contains either pointer to data member or pointers to getter/setter which are used to get / set stuff
+Access kind is a part of the type, so Member stores only pointers it needs and get/set don't have
+to check at runtime which of them are set.
+Non-const getter can be added to getter/setter members via fluent interface (see addNonConstGetter)
+Ref getter/setter members can also get rvalue setter which is used when rvalue is passed to set
+(see addRvalueSetter), so big values are moved into object instead of being copied
+
+Constructors, meta::member(...) and the fluent functions are constexpr, so registerMembers<T>
+specializations can be constexpr and member tables of the class become compile time constants
+(see MetaHolder.h)
 
 -------------------------------------------------------------------------------------------------*/
 
 #pragma once
 
+#include <string_view>
+
+#include "detail/string_hash.h"
 
 namespace meta
 {
@@ -34,25 +44,66 @@ using val_getter_func_ptr_t = T(Class::*)() const;
 template <typename Class, typename T>
 using val_setter_func_ptr_t = void (Class::*)(T);
 
+// rvalue setter, used when Member::set gets rvalue
+template <typename Class, typename T>
+using rvalue_setter_func_ptr_t = void (Class::*)(T&&);
+
 // non const reference getter
 template <typename Class, typename T>
 using nonconst_ref_getter_func_ptr_t = T& (Class::*)();
 
-// MemberType is Member<T, Class>
+enum class AccessKind {
+    DataMember,    // T Class::*
+    RefAccessors,  // const T& (Class::*)() const and void (Class::*)(const T&)
+    ValueAccessors // T (Class::*)() const and void (Class::*)(T)
+};
+
+// MemberType is Member<T, Class, Kind>
 template <typename MemberType>
 using get_member_type = typename std::decay_t<MemberType>::member_type;
 
+namespace detail
+{
+
+// pointers needed by each access kind
+template <typename Class, typename T, AccessKind Kind>
+struct MemberAccess;
+
+template <typename Class, typename T>
+struct MemberAccess<Class, T, AccessKind::DataMember> {
+    member_ptr_t<Class, T> ptr;
+};
+
+template <typename Class, typename T>
+struct MemberAccess<Class, T, AccessKind::RefAccessors> {
+    ref_getter_func_ptr_t<Class, T> getter;
+    ref_setter_func_ptr_t<Class, T> setter;
+    rvalue_setter_func_ptr_t<Class, T> rvalueSetter;
+    nonconst_ref_getter_func_ptr_t<Class, T> nonConstGetter;
+};
+
 template <typename Class, typename T>
+struct MemberAccess<Class, T, AccessKind::ValueAccessors> {
+    val_getter_func_ptr_t<Class, T> getter;
+    val_setter_func_ptr_t<Class, T> setter;
+    nonconst_ref_getter_func_ptr_t<Class, T> nonConstGetter;
+};
+
+} // end of namespace detail
+
+template <typename Class, typename T, AccessKind Kind = AccessKind::DataMember>
 class Member {
 public:
     using class_type = Class;
     using member_type = T;
+    static constexpr AccessKind access_kind = Kind;
 
-    Member(const char* name, member_ptr_t<Class, T> ptr);
-    Member(const char* name, ref_getter_func_ptr_t<Class, T> getterPtr, ref_setter_func_ptr_t<Class, T> setterPtr);
-    Member(const char* name, val_getter_func_ptr_t<Class, T> getterPtr, val_setter_func_ptr_t<Class, T> setterPtr);
+    constexpr Member(const char* name, member_ptr_t<Class, T> ptr);
+    constexpr Member(const char* name, ref_getter_func_ptr_t<Class, T> getterPtr, ref_setter_func_ptr_t<Class, T> setterPtr);
+    constexpr Member(const char* name, val_getter_func_ptr_t<Class, T> getterPtr, val_setter_func_ptr_t<Class, T> setterPtr);
 
-    Member& addNonConstGetter(nonconst_ref_getter_func_ptr_t<Class, T> nonConstRefGetterPtr);
+    constexpr Member& addNonConstGetter(nonconst_ref_getter_func_ptr_t<Class, T> nonConstRefGetterPtr);
+    constexpr Member& addRvalueSetter(rvalue_setter_func_ptr_t<Class, T> rvalueSetterPtr);
 
     // get sets methods can be used to add support
     // for getters/setters for members instead of
@@ -64,27 +115,23 @@ public:
 
     template <typename V,
         typename = std::enable_if_t<std::is_constructible<T, V>::value>>
-        void set(Class& obj, V&& value) const; // accepts lvalues and rvalues!
-
-    const char* getName() const { return name; }
-    bool hasPtr() const { return hasMemberPtr; }
-    bool hasGetter() const { return refGetterPtr || valGetterPtr; }
-    bool hasSetter() const { return refSetterPtr || valSetterPtr; }
-    bool canGetConstRef() const { return hasMemberPtr || refGetterPtr; }
-    bool canGetRef() const { return hasMemberPtr || nonConstRefGetterPtr; }
-private:
-    const char* name;
-    member_ptr_t<Class, T> ptr;
-    bool hasMemberPtr; // first member of class can be nullptr
-                       // so we need this var to know if member ptr is present
+        void set(Class& obj, V&& value) const; // accepts lvalues and rvalues, rvalues are moved
 
-    ref_getter_func_ptr_t<Class, T> refGetterPtr;
-    ref_setter_func_ptr_t<Class, T> refSetterPtr;
+    constexpr const char* getName() const { return name.data(); } // always null-terminated
+    constexpr std::string_view getNameView() const { return name; } // length is computed once, in constructor
+    constexpr detail::name_hash_t getNameHash() const { return nameHash; } // detail::hashString of name
 
-    val_getter_func_ptr_t<Class, T> valGetterPtr;
-    val_setter_func_ptr_t<Class, T> valSetterPtr;
+    // these depend only on access kind, so they can be used in if constexpr
+    static constexpr bool hasPtr() { return Kind == AccessKind::DataMember; }
+    static constexpr bool hasGetter() { return Kind != AccessKind::DataMember; }
+    static constexpr bool hasSetter() { return Kind != AccessKind::DataMember; }
+    static constexpr bool canGetConstRef() { return Kind != AccessKind::ValueAccessors; }
 
-    nonconst_ref_getter_func_ptr_t<Class, T> nonConstRefGetterPtr;
+    constexpr bool canGetRef() const;
+private:
+    std::string_view name;
+    detail::name_hash_t nameHash;
+    detail::MemberAccess<Class, T, Kind> access;
 };
 
 // useful function similar to make_pair which is used so you don't have to write this:
@@ -92,13 +139,15 @@ private:
 // member("someName", &SomeClass::someInt);
 
 template <typename Class, typename T>
-Member<Class, T> member(const char* name, T Class::* ptr);
+constexpr Member<Class, T, AccessKind::DataMember> member(const char* name, T Class::* ptr);
 
 template <typename Class, typename T>
-Member<Class, T> member(const char* name, ref_getter_func_ptr_t<Class, T> getterPtr, ref_setter_func_ptr_t<Class, T> setterPtr);
+constexpr Member<Class, T, AccessKind::RefAccessors> member(const char* name,
+    ref_getter_func_ptr_t<Class, T> getterPtr, ref_setter_func_ptr_t<Class, T> setterPtr);
 
 template <typename Class, typename T>
-Member<Class, T> member(const char* name, val_getter_func_ptr_t<Class, T> getterPtr, val_setter_func_ptr_t<Class, T> setterPtr);
+constexpr Member<Class, T, AccessKind::ValueAccessors> member(const char* name,
+    val_getter_func_ptr_t<Class, T> getterPtr, val_setter_func_ptr_t<Class, T> setterPtr);
 
 } // end of namespace meta
 
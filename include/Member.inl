@@ -1,126 +1,154 @@
+#include <cassert>
 #include <stdexcept>
 
 namespace meta
 {
 
-template <typename Class, typename T>
-Member<Class, T>::Member(const char* name, member_ptr_t<Class, T> ptr) :
+template <typename Class, typename T, AccessKind Kind>
+constexpr Member<Class, T, Kind>::Member(const char* name, member_ptr_t<Class, T> ptr) :
     name(name),
-    ptr(ptr),
-    hasMemberPtr(true),
-    refGetterPtr(nullptr),
-    refSetterPtr(nullptr),
-    valGetterPtr(nullptr),
-    valSetterPtr(nullptr),
-    nonConstRefGetterPtr(nullptr)
-{ }
+    nameHash(detail::hashString(name)),
+    access{ ptr }
+{
+    static_assert(Kind == AccessKind::DataMember, "Member pointer can only be used with AccessKind::DataMember");
+}
 
-template <typename Class, typename T>
-Member<Class, T>::Member(const char* name, ref_getter_func_ptr_t<Class, T> getterPtr, ref_setter_func_ptr_t<Class, T> setterPtr) : 
+template <typename Class, typename T, AccessKind Kind>
+constexpr Member<Class, T, Kind>::Member(const char* name, ref_getter_func_ptr_t<Class, T> getterPtr, ref_setter_func_ptr_t<Class, T> setterPtr) :
     name(name),
-    ptr(nullptr),
-    hasMemberPtr(false),
-    refGetterPtr(getterPtr),
-    refSetterPtr(setterPtr),
-    valGetterPtr(nullptr),
-    valSetterPtr(nullptr),
-    nonConstRefGetterPtr(nullptr)
-{ }
+    nameHash(detail::hashString(name)),
+    access{ getterPtr, setterPtr, nullptr, nullptr }
+{
+    static_assert(Kind == AccessKind::RefAccessors, "Ref getter/setter can only be used with AccessKind::RefAccessors");
+    assert(getterPtr && setterPtr && "Getter and setter should be set");
+}
 
-template <typename Class, typename T>
-Member<Class, T>::Member(const char* name, val_getter_func_ptr_t<Class, T> getterPtr, val_setter_func_ptr_t<Class, T> setterPtr) :
+template <typename Class, typename T, AccessKind Kind>
+constexpr Member<Class, T, Kind>::Member(const char* name, val_getter_func_ptr_t<Class, T> getterPtr, val_setter_func_ptr_t<Class, T> setterPtr) :
     name(name),
-    ptr(nullptr),
-    hasMemberPtr(false),
-    refGetterPtr(nullptr),
-    refSetterPtr(nullptr),
-    valGetterPtr(getterPtr),
-    valSetterPtr(setterPtr),
-    nonConstRefGetterPtr(nullptr)
-{ }
+    nameHash(detail::hashString(name)),
+    access{ getterPtr, setterPtr, nullptr }
+{
+    static_assert(Kind == AccessKind::ValueAccessors, "Value getter/setter can only be used with AccessKind::ValueAccessors");
+    assert(getterPtr && setterPtr && "Getter and setter should be set");
+}
 
-template <typename Class, typename T>
-Member<Class, T>& Member<Class, T>::addNonConstGetter(nonconst_ref_getter_func_ptr_t<Class, T> nonConstRefGetterPtr)
+template <typename Class, typename T, AccessKind Kind>
+constexpr Member<Class, T, Kind>& Member<Class, T, Kind>::addNonConstGetter(nonconst_ref_getter_func_ptr_t<Class, T> nonConstRefGetterPtr)
 {
-    this->nonConstRefGetterPtr = nonConstRefGetterPtr;
+    static_assert(Kind != AccessKind::DataMember, "Member pointer already gives non const access to member");
+    access.nonConstGetter = nonConstRefGetterPtr;
     return *this;
 }
 
-template <typename Class, typename T>
-const T& Member<Class, T>::get(const Class& obj) const
+template <typename Class, typename T, AccessKind Kind>
+constexpr Member<Class, T, Kind>& Member<Class, T, Kind>::addRvalueSetter(rvalue_setter_func_ptr_t<Class, T> rvalueSetterPtr)
+{
+    static_assert(Kind == AccessKind::RefAccessors,
+        "Only ref setters need rvalue setter, data members and value setters already move rvalues");
+    access.rvalueSetter = rvalueSetterPtr;
+    return *this;
+}
+
+template <typename Class, typename T, AccessKind Kind>
+const T& Member<Class, T, Kind>::get(const Class& obj) const
 {
-    if (refGetterPtr) {
-        return (obj.*refGetterPtr)();
-    } else if (hasMemberPtr) {
-        return obj.*ptr;
+    if constexpr (Kind == AccessKind::DataMember) {
+        return obj.*access.ptr;
+    } else if constexpr (Kind == AccessKind::RefAccessors) {
+        return (obj.*access.getter)();
+    } else {
+        throw std::runtime_error("Cannot return const ref to member: only value getter is set");
     }
-    throw std::runtime_error("Cannot return const ref to member: no getter or member pointer set");
 }
 
-template <typename Class, typename T>
-T Member<Class, T>::getCopy(const Class& obj) const
+template <typename Class, typename T, AccessKind Kind>
+T Member<Class, T, Kind>::getCopy(const Class& obj) const
 {
-    if (refGetterPtr) {
-        return (obj.*refGetterPtr)();
-    } else if (valGetterPtr) {
-        return (obj.*valGetterPtr)();
-    } else if (hasMemberPtr) {
-        return obj.*ptr;
+    if constexpr (Kind == AccessKind::DataMember) {
+        return obj.*access.ptr;
+    } else {
+        return (obj.*access.getter)();
     }
-    throw std::runtime_error("Cannot return copy of member: no getter or member pointer set");
 }
 
-template <typename Class, typename T>
-T& Member<Class, T>::getRef(Class& obj) const
+template <typename Class, typename T, AccessKind Kind>
+T& Member<Class, T, Kind>::getRef(Class& obj) const
 {
-    if (nonConstRefGetterPtr) {
-        (obj.*nonConstRefGetterPtr)();
-    } else if(hasMemberPtr) {
-        return obj.*ptr;
+    if constexpr (Kind == AccessKind::DataMember) {
+        return obj.*access.ptr;
+    } else {
+        if (access.nonConstGetter) {
+            return (obj.*access.nonConstGetter)();
+        }
+        throw std::runtime_error("Cannot return ref to member: no non const getter set");
     }
-    throw std::runtime_error("Cannot return ref to member: no getter or member pointer set");
 }
 
-template <typename Class, typename T>
-member_ptr_t<Class, T> Member<Class, T>::getPtr() const {
-    if (hasPtr()) {
-        return ptr;
+template <typename Class, typename T, AccessKind Kind>
+member_ptr_t<Class, T> Member<Class, T, Kind>::getPtr() const
+{
+    if constexpr (Kind == AccessKind::DataMember) {
+        return access.ptr;
+    } else {
+        throw std::runtime_error("Cannot get pointer to member: it wasn't set");
+    }
+}
+
+template <typename Class, typename T, AccessKind Kind>
+constexpr bool Member<Class, T, Kind>::canGetRef() const
+{
+    if constexpr (Kind == AccessKind::DataMember) {
+        return true;
+    } else {
+        return access.nonConstGetter != nullptr;
     }
-    throw std::runtime_error("Cannot get pointer to member: it wasn't set");
 }
 
-template<typename Class, typename T>
+template <typename Class, typename T, AccessKind Kind>
 template <typename V, typename>
-void Member<Class, T>::set(Class& obj, V&& value) const
+void Member<Class, T, Kind>::set(Class& obj, V&& value) const
 {
-    // TODO: add rvalueSetter?
-    if (refSetterPtr) {
-        (obj.*refSetterPtr)(value);
-    } else if (valSetterPtr) {
-        (obj.*valSetterPtr)(value); // will copy value
-    } else if (hasMemberPtr) {
-        obj.*ptr = value;
+    if constexpr (Kind == AccessKind::DataMember) {
+        obj.*access.ptr = std::forward<V>(value);
+    } else if constexpr (Kind == AccessKind::ValueAccessors) {
+        (obj.*access.setter)(std::forward<V>(value)); // copies lvalues and moves rvalues
+    } else if constexpr (!std::is_same<std::decay_t<V>, T>::value) {
+        // temporary T is created anyway, so it can be moved
+        if (access.rvalueSetter) {
+            (obj.*access.rvalueSetter)(T(std::forward<V>(value)));
+        } else {
+            (obj.*access.setter)(T(std::forward<V>(value)));
+        }
+    } else if constexpr (!std::is_lvalue_reference<V>::value && !std::is_const<std::remove_reference_t<V>>::value) {
+        if (access.rvalueSetter) {
+            (obj.*access.rvalueSetter)(std::move(value));
+        } else {
+            (obj.*access.setter)(value);
+        }
     } else {
-        throw std::runtime_error("Cannot access member: no setter or member pointer set");
+        (obj.*access.setter)(value);
     }
 }
 
 template <typename Class, typename T>
-Member<Class, T> member(const char* name, T Class::* ptr)
+constexpr Member<Class, T, AccessKind::DataMember> member(const char* name, T Class::* ptr)
 {
-    return Member<Class, T>(name, ptr);
+    return Member<Class, T, AccessKind::DataMember>(name, ptr);
 }
 
 template <typename Class, typename T>
-Member<Class, T> member(const char* name, ref_getter_func_ptr_t<Class, T> getterPtr, ref_setter_func_ptr_t<Class, T> setterPtr)
+constexpr Member<Class, T, AccessKind::RefAccessors> member(const char* name,
+    ref_getter_func_ptr_t<Class, T> getterPtr, ref_setter_func_ptr_t<Class, T> setterPtr)
 {
-    return Member<Class, T>(name, getterPtr, setterPtr);
+    return Member<Class, T, AccessKind::RefAccessors>(name, getterPtr, setterPtr);
 }
 
 template <typename Class, typename T>
-Member<Class, T> member(const char* name, val_getter_func_ptr_t<Class, T> getterPtr, val_setter_func_ptr_t<Class, T> setterPtr)
+constexpr Member<Class, T, AccessKind::ValueAccessors> member(const char* name,
+    val_getter_func_ptr_t<Class, T> getterPtr, val_setter_func_ptr_t<Class, T> setterPtr)
 {
-    return Member<Class, T>(name, getterPtr, setterPtr);
+    return Member<Class, T, AccessKind::ValueAccessors>(name, getterPtr, setterPtr);
 }
 
 } // end of namespace meta
\ No newline at end of file
@@ -0,0 +1,69 @@
+/* -----------------------------------------------------------------------------------------------
+
+MemberAccessor<Class> is type erased version of Member<Class, T>
+It's used when member is chosen at runtime (by index or by name) and you don't want to
+iterate over members tuple to find it: get/set are plain function pointers, so access
+is a single indirect call.
+
+Values are passed through void pointers, which should point to object of member type.
+Check it with accessor.is<T>() or compare accessor.type with meta::typeId<T>()
+
+Accessor tables are built once per class by MetaHolder, see meta::getMemberAccessors<Class>()
+They're built at compile time for classes with constexpr registerMembers
+
+-------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace meta
+{
+
+// Unique id of type which doesn't need RTTI
+using type_id_t = const void*;
+
+template <typename T>
+constexpr type_id_t typeId();
+
+template <typename Class>
+struct MemberAccessor {
+    using class_type = Class;
+
+    const char* name;
+    type_id_t type;
+
+    // copies member value to *out (nullptr if member type is not copyable)
+    void (*get)(const Class& obj, void* out);
+    // copies *value to member (nullptr if member type is not copyable)
+    void (*set)(Class& obj, const void* value);
+    // moves *value to member (nullptr if member type is not movable)
+    void (*move)(Class& obj, void* value);
+    // address of member or nullptr if it can only be accessed by value getter
+    const void* (*getPtr)(const Class& obj);
+
+    template <typename T>
+    bool is() const { return type == typeId<T>(); }
+};
+
+namespace detail
+{
+
+template <typename T>
+struct type_id_holder {
+    static constexpr char id = 0;
+};
+
+// Builds array of accessors, one per member in TupleType
+// Member names are taken from 'members', functions access members through meta::getMembers<Class>
+template <typename Class, typename TupleType>
+constexpr auto makeMemberAccessors(const TupleType& members);
+
+} // end of namespace detail
+
+} // end of namespace meta
+
+#include "MemberAccessor.inl"
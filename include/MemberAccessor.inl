@@ -0,0 +1,69 @@
+namespace meta
+{
+
+template <typename T>
+constexpr type_id_t typeId()
+{
+    return &detail::type_id_holder<T>::id;
+}
+
+namespace detail
+{
+
+template <typename Class, std::size_t I>
+const auto& getMemberAt()
+{
+    return std::get<I>(getMembers<Class>());
+}
+
+template <typename Class, std::size_t I, typename MemberType>
+constexpr MemberAccessor<Class> makeMemberAccessor(const MemberType& member)
+{
+    using T = get_member_type<MemberType>;
+    MemberAccessor<Class> accessor{ member.getName(), typeId<T>(), nullptr, nullptr, nullptr, nullptr };
+    if constexpr (std::is_copy_assignable<T>::value) { // otherwise get/set stay nullptr
+        accessor.get = [](const Class& obj, void* out)
+        {
+            *static_cast<T*>(out) = getMemberAt<Class, I>().getCopy(obj);
+        };
+        accessor.set = [](Class& obj, const void* value)
+        {
+            getMemberAt<Class, I>().set(obj, *static_cast<const T*>(value));
+        };
+    }
+    if constexpr (std::is_move_assignable<T>::value) {
+        accessor.move = [](Class& obj, void* value)
+        {
+            getMemberAt<Class, I>().set(obj, std::move(*static_cast<T*>(value)));
+        };
+    }
+    accessor.getPtr = [](const Class& obj) -> const void*
+    {
+        if constexpr (MemberType::canGetConstRef()) {
+            return &getMemberAt<Class, I>().get(obj);
+        } else {
+            return nullptr;
+        }
+    };
+    return accessor;
+}
+
+template <typename Class, typename TupleType, std::size_t... I>
+constexpr auto makeMemberAccessors(const TupleType& members, std::index_sequence<I...>)
+{
+    (void)members; // unused for classes without members
+    return std::array<MemberAccessor<Class>, sizeof...(I)>{ {
+        makeMemberAccessor<Class, I>(std::get<I>(members))...
+    } };
+}
+
+template <typename Class, typename TupleType>
+constexpr auto makeMemberAccessors(const TupleType& members)
+{
+    constexpr std::size_t memberCount = std::tuple_size<TupleType>::value;
+    return makeMemberAccessors<Class>(members, std::make_index_sequence<memberCount>());
+}
+
+} // end of namespace detail
+
+} // end of namespace meta
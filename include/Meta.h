@@ -18,8 +18,8 @@ auto registerMembers<YourClass>()
 
 ! Some important details:
 1) This specialization should be defined in header, because compiler needs to deduce the return type.
-2) This function is called by MetaHolder during it's static member initialization, so the tuple is created
-   only once and then registerMembers function is never called again.
+2) This function is called by MetaHolder when members of the class are accessed for the first time,
+   so the tuple is created only once and then registerMembers function is never called again.
 3) registerMembers could easily be a free function, but befriending such function is hard if you want to
    be able to get pointers to private members... Writing "friend class Meta" in your preferred class
    is just much easier. Though this might be somehow fixed in the future.
@@ -27,6 +27,15 @@ auto registerMembers<YourClass>()
    because the function will return empty tuple.
 5) MemberPtr.h is included in this file just so that user can #include "Meta.h" and get MemberPtr.h
    included too, which is always needed for registration.
+6) Specialization can be constexpr instead of inline (constexpr functions are inline anyway):
+
+       template <>
+       constexpr auto registerMembers<YourClass>() { ... }
+
+   Then member tuple, name index and accessors are built at compile time and placed in read-only
+   data, doForAllMembers can be fully inlined and memberIndex, hasMember and schemaHash can be
+   used in constant expressions, e.g. static_assert(meta::hasMember<YourClass>("name")).
+   Non-constexpr registerMembers still works, its tables are built on first use.
 
 -------------------------------------------------------------------------------------------------*/
 
@@ -36,10 +45,14 @@ auto registerMembers<YourClass>()
 #pragma warning (disable : 4396) // silly VS warning about inline friend stuff...
 #endif
 
+#include <cstdint>
 #include <type_traits>
 #include <tuple>
 #include <utility>
 #include <string>
+#include <string_view>
+
+#include "detail/NameIndex.h"
 
 // type_list is array of types
 template <typename... Args>
@@ -55,11 +68,11 @@ namespace meta
 {
 
 template <typename... Args>
-auto members(Args&&... args);
+constexpr auto members(Args&&... args);
 
 // function used for registration of classes by user
 template <typename Class>
-inline auto registerMembers();
+constexpr auto registerMembers();
 
 // function used for registration of class name by user
 template <typename Class>
@@ -71,16 +84,34 @@ constexpr auto getName();
 
 // returns std::tuple of Members
 template <typename Class>
-const auto& getMembers();
+constexpr const auto& getMembers();
 
-// Check if class has registerMembers<T> specialization (has been registered)
+// returns std::array of MemberAccessor<Class>, in the same order as getMembers<Class>()
 template <typename Class>
-constexpr bool isRegistered();
+constexpr const auto& getMemberAccessors();
 
-// Check if Class has non-default ctor registered
 template <typename Class>
-constexpr bool ctorRegistered();
+struct MemberAccessor;
+
+// returns accessor of member named 'name' or nullptr
+template <typename Class>
+const MemberAccessor<Class>* getMemberAccessor(std::string_view name);
 
+// Check if class has registerMembers<T> specialization (has been registered)
+template <typename Class>
+constexpr bool isRegistered();
+
+// Registration of constructor which deserializers use instead of default constructor.
+// Specialization lists types of constructor parameters and names of members which provide them:
+//
+//     template <>
+//     struct constructor_args<MovieInfo> {
+//         using types = type_list<std::string, float>;
+//         static constexpr const char* members[] = { "name", "rating" };
+//     };
+//
+// Then Class(arg0, arg1, ...) is called with decoded values of these members,
+// other members are decoded into constructed object
 template <typename T>
 struct constructor_args {
     using types = type_list<>;
@@ -93,26 +124,70 @@ using constructor_arguments = typename constructor_args<T>::types;
 template <typename Class>
 constexpr bool ctorRegistered();
 
+// Constructs Class with registered constructor. makeArg(member) is called for member which
+// provides each argument and returns its value. Throws std::runtime_error if constructor_args
+// names a member which is not registered
+template <typename Class, typename F>
+Class constructWith(F&& makeArg);
+
+// Check if member with index 'index' in getMembers<Class>() tuple provides constructor argument
+template <typename Class>
+bool isConstructorArgument(std::size_t index);
+
+// Check if all members of Class are pointers to data members of trivially copyable types
+// and their sizes add up to sizeof(Class), so there are no padding bytes in Class objects.
+// Order of members in memory is not checked, member pointers are not known at compile time
+template <typename Class>
+constexpr bool isTriviallyPacked();
+
+// Returned by memberIndex if there's no member with such name
+constexpr std::size_t npos = detail::NameIndex<0>::npos;
+
+// Number of registered members of class
+template <typename Class>
+constexpr std::size_t getMemberCount();
+
+// Index of member named 'name' in getMembers<Class>() tuple or meta::npos.
+// Uses name index precomputed once per class, so its cost doesn't depend on number of members
+template <typename Class>
+constexpr std::size_t memberIndex(std::string_view name);
+
 // Check if class T has member
+// All name lookups go through memberIndex<Class>.
+// std::string_view is accepted, so no temporary std::string is created for literals
 template <typename Class>
-bool hasMember(const std::string& name);
+constexpr bool hasMember(std::string_view name);
+
+template <typename Class, typename F>
+constexpr void doForAllMembers(F&& f);
 
+// Calls f for members in registration order until it returns true,
+// returns true if iteration was stopped by f
 template <typename Class, typename F>
-void doForAllMembers(F&& f);
+constexpr bool doForAllMembersUntil(F&& f);
+
+// 64-bit fingerprint of registered name, member names, member types and their order,
+// nested registered classes and containers are included recursively (see detail/SchemaHash.h).
+// It doesn't depend on compiler, so peers can compare hashes to check that they agree on layout.
+// Works for non-registered types too, e.g. schemaHash<std::vector<Person>>(). Computed once per type,
+// at compile time if all registered classes it depends on have constexpr registerMembers
+template <typename T>
+constexpr std::uint64_t schemaHash();
 
 // Do F for member named 'name' with type T. It's important to pass correct type of the member
 template <typename Class, typename T, typename F>
-void doForMember(const std::string& name, F&& f);
+void doForMember(std::string_view name, F&& f);
 
 // Get value of the member named 'name'
 template <typename T, typename Class>
-T getMemberValue(Class& obj, const std::string& name);
+T getMemberValue(Class& obj, std::string_view name);
 
 // Set value of the member named 'name'
 template <typename T, typename Class, typename V,
     typename = std::enable_if_t<std::is_constructible<T, V>::value>>
-void setMemberValue(Class& obj, const std::string& name, V&& value);
+void setMemberValue(Class& obj, std::string_view name, V&& value);
 
 }
 
+#include "Stats.h"
 #include "Meta.inl"
@@ -1,15 +1,22 @@
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 
 #include "Member.h"
+#include "MemberAccessor.h"
 #include "detail/template_helpers.h"
 #include "detail/MetaHolder.h"
+#include "detail/SchemaHash.h"
 
 namespace meta
 {
 
 template <typename... Args>
-auto members(Args&&... args)
+constexpr auto members(Args&&... args)
 {
     // just this... but may become more complex later, who knows!
     //  Still, better no to expose too much to end-user.
@@ -17,7 +24,7 @@ auto members(Args&&... args)
 }
 
 template <typename Class>
-inline auto registerMembers()
+constexpr auto registerMembers()
 {
     return std::make_tuple();
 }
@@ -35,9 +42,22 @@ constexpr auto getName()
 }
 
 template <typename Class>
-const auto& getMembers()
+constexpr const auto& getMembers()
 {
-    return detail::MetaHolder<Class, decltype(registerMembers<Class>())>::members;
+    return detail::MetaHolder<Class, decltype(registerMembers<Class>())>::members();
+}
+
+template <typename Class>
+constexpr const auto& getMemberAccessors()
+{
+    return detail::MetaHolder<Class, decltype(registerMembers<Class>())>::accessors();
+}
+
+template <typename Class>
+const MemberAccessor<Class>* getMemberAccessor(std::string_view name)
+{
+    const auto index = memberIndex<Class>(name);
+    return index != npos ? &getMemberAccessors<Class>()[index] : nullptr;
 }
 
 template <typename Class>
@@ -53,45 +73,167 @@ constexpr bool ctorRegistered()
     return !std::is_same<type_list<>, constructor_arguments<Class>>::value;
 }
 
+namespace detail
+{
+
+template <typename Class, std::size_t... I>
+std::array<std::size_t, sizeof...(I)> makeConstructorIndices(std::index_sequence<I...>)
+{
+    const std::array<std::size_t, sizeof...(I)> indices{ { memberIndex<Class>(constructor_args<Class>::members[I])... } };
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        if (indices[i] == npos) {
+            throw std::runtime_error(std::string("Error: constructor argument '") +
+                constructor_args<Class>::members[i] + "' is not a registered member");
+        }
+    }
+    return indices;
+}
+
+// indices of members which provide constructor arguments, names are looked up once per class
 template <typename Class>
-bool hasMember(const std::string& name)
+const auto& constructorIndices()
+{
+    static const auto indices = makeConstructorIndices<Class>(typename constructor_arguments<Class>::indices());
+    return indices;
+}
+
+template <typename Arg, typename Class, typename F>
+Arg makeConstructorArg(std::size_t index, F& makeArg)
 {
-    bool found = false;
-    doForAllMembers<Class>(
-        [&found, &name](const auto& member)
+    std::optional<Arg> arg; // Arg doesn't have to be default constructible
+    for_tuple_at(index,
+        [&arg, &makeArg](const auto& member)
         {
-            if (member.getName() == name) {
-                found = true;
+            using MemberT = get_member_type<decltype(member)>;
+            if constexpr (std::is_constructible<Arg, MemberT&&>::value) {
+                arg.emplace(makeArg(member));
             }
-        }
+        },
+        getMembers<Class>()
     );
-    return found;
+    if (!arg) {
+        throw std::runtime_error("Error: constructor argument can't be made from member of its type");
+    }
+    return std::move(*arg);
+}
+
+template <typename Class, typename F, std::size_t... I>
+Class constructWith(F& makeArg, std::index_sequence<I...>)
+{
+    using Args = constructor_arguments<Class>;
+    const auto& indices = constructorIndices<Class>();
+    return Class(makeConstructorArg<std::decay_t<typename Args::template type<I>>, Class>(indices[I], makeArg)...);
 }
 
+} // end of namespace detail
+
 template <typename Class, typename F>
-void doForAllMembers(F&& f)
+Class constructWith(F&& makeArg)
+{
+    static_assert(ctorRegistered<Class>(), "Class has no registered constructor");
+    using Args = constructor_arguments<Class>;
+    static_assert(Args::size == std::extent<decltype(constructor_args<Class>::members)>::value,
+        "constructor_args should name one member per constructor argument");
+    return detail::constructWith<Class>(makeArg, typename Args::indices());
+}
+
+template <typename Class>
+bool isConstructorArgument(std::size_t index)
+{
+    if constexpr (ctorRegistered<Class>()) {
+        const auto& indices = detail::constructorIndices<Class>();
+        return std::find(indices.begin(), indices.end(), index) != indices.end();
+    } else {
+        return false;
+    }
+}
+
+namespace detail
+{
+
+template <typename Class, typename TupleType>
+struct is_trivially_packed : std::false_type { };
+
+template <typename Class, typename... Members>
+struct is_trivially_packed<Class, std::tuple<Members...>> : std::integral_constant<bool,
+    sizeof...(Members) != 0 && std::is_trivially_copyable<Class>::value &&
+    ((std::decay_t<Members>::access_kind == AccessKind::DataMember) && ...) &&
+    (std::is_trivially_copyable<get_member_type<Members>>::value && ...) &&
+    (sizeof(get_member_type<Members>) + ... + 0) == sizeof(Class)> { };
+
+} // end of namespace detail
+
+template <typename Class>
+constexpr bool isTriviallyPacked()
+{
+    return detail::is_trivially_packed<Class, decltype(registerMembers<Class>())>::value;
+}
+
+template <typename Class>
+constexpr std::size_t getMemberCount()
+{
+    return std::tuple_size<decltype(registerMembers<Class>())>::value;
+}
+
+template <typename Class>
+constexpr std::size_t memberIndex(std::string_view name)
+{
+    return detail::MetaHolder<Class, decltype(registerMembers<Class>())>::nameIndex().find(name);
+}
+
+template <typename Class>
+constexpr bool hasMember(std::string_view name)
+{
+    return memberIndex<Class>(name) != npos;
+}
+
+template <typename Class, typename F>
+constexpr void doForAllMembers(F&& f)
 {
     //static_assert(isRegistered<Class>(), "Class is not registered");
+    detail::countMemberIteration<Class>();
     detail::for_tuple(std::forward<F>(f), getMembers<Class>());
 }
 
+template <typename Class, typename F>
+constexpr bool doForAllMembersUntil(F&& f)
+{
+    detail::countMemberIteration<Class>();
+    return detail::for_tuple_until(std::forward<F>(f), getMembers<Class>());
+}
+
+template <typename T>
+constexpr std::uint64_t schemaHash()
+{
+    if constexpr (detail::is_constant_schema<T>::value) {
+        return detail::constant_schema_hash<T>::value;
+    } else {
+        return detail::cachedSchemaHash<T>();
+    }
+}
+
 template <typename Class, typename T, typename F>
-void doForMember(const std::string& name, F&& f)
+void doForMember(std::string_view name, F&& f)
 {
-    doForAllMembers<Class>(
-        [&](const auto& member)
+    const auto index = memberIndex<Class>(name);
+    if (index == npos) {
+        return;
+    }
+    detail::for_tuple_at(index,
+        [&f](const auto& member)
         {
-            if (member.getName() == name) {
-                using MemberT = meta::get_member_type<decltype(member)>;
-                assert((std::is_same<MemberT, T>::value) && "Member doesn't have type T");
-                detail::call_if<std::is_same<MemberT, T>::value>(std::forward<F>(f), member);
+            using MemberT = meta::get_member_type<decltype(member)>;
+            assert((std::is_same<MemberT, T>::value) && "Member doesn't have type T");
+            if constexpr (std::is_same<MemberT, T>::value) { // f is not instantiated for other types
+                f(member);
             }
-        }
+        },
+        getMembers<Class>()
     );
 }
 
 template <typename T, typename Class>
-T getMemberValue(Class& obj, const std::string& name)
+T getMemberValue(Class& obj, std::string_view name)
 {
     T value;
     doForMember<Class, T>(name,
@@ -105,12 +247,12 @@ T getMemberValue(Class& obj, const std::string& name)
 
 template <typename T, typename Class, typename V,
     typename>
-void setMemberValue(Class& obj, const std::string& name, V&& value)
+void setMemberValue(Class& obj, std::string_view name, V&& value)
 {
     doForMember<Class, T>(name,
-        [&obj, value = std::forward<V>(value)](const auto& member)
+        [&obj, &value](const auto& member)
         {
-            member.set(obj, value);
+            member.set(obj, std::forward<V>(value)); // called only once, so it's fine to forward
         }
     );
 }
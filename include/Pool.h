@@ -0,0 +1,95 @@
+/* -----------------------------------------------------------------------------------------------
+
+meta::pool<Class> keeps released objects and hands them out again, so when a stream of messages
+is decoded in place into pooled objects, their strings and containers reuse storage left by
+previous messages instead of allocating for each one:
+
+    meta::pool<Order> orders;
+
+    void onMessage(std::string_view text)
+    {
+        auto order = orders.acquire(); // pool<Order>::handle, returns object to pool when destroyed
+        Json::read(*order, text);      // or Binary::deserialize(*order, data)
+        process(*order);
+    }
+
+Released objects are reset with meta::resetMembers: numbers are zeroed, strings are cleared but
+keep their capacity, nested registered classes are reset recursively. Containers depend on
+reset_policy of the pool:
+- reset_policy::clear (default): containers are cleared, so each acquired object looks like a new
+  one. Destroyed elements take their storage with them, so only the containers' own buffers
+  are reused.
+- reset_policy::keepElements: elements of vectors and values of maps are reset recursively, but stay
+  in containers. Readers decode in place into existing elements and entries with the same keys,
+  then trim the rest, so once storage has grown decoding allocates next to nothing. But containers
+  of members which are missing from input keep their reset elements, so use it only when messages
+  always have these members.
+Reset matters because readers leave members which are missing from input untouched.
+
+New objects are default constructed. Classes which are not default constructible are built
+with their registered constructor (see meta::constructor_args) from default constructed arguments.
+Pool should outlive handles it gave out. It's not thread safe, use one pool per thread.
+
+-------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Meta.h"
+
+namespace meta
+{
+
+enum class reset_policy {
+    clear,       // containers are cleared
+    keepElements // elements of containers are reset, but not removed
+};
+
+// Resets registered members of obj to default values, keeping capacity of strings and containers
+template <typename Class>
+void resetMembers(Class& obj, reset_policy policy = reset_policy::clear);
+
+template <typename Class>
+class pool {
+    static_assert(isRegistered<Class>(), "Class is not registered");
+public:
+    class deleter {
+    public:
+        deleter() = default;
+        explicit deleter(pool* owner) : owner(owner) { }
+        void operator()(Class* obj) const;
+    private:
+        pool* owner = nullptr;
+    };
+
+    using handle = std::unique_ptr<Class, deleter>;
+
+    // at most maxIdle released objects are kept, others are deleted
+    explicit pool(std::size_t maxIdle = 64, reset_policy policy = reset_policy::clear);
+    pool(const pool&) = delete;
+    pool& operator=(const pool&) = delete;
+
+    // returns idle object or creates a new one
+    handle acquire();
+    // creates idle objects until there are 'count' of them (but no more than maxIdle)
+    void reserve(std::size_t count);
+
+    std::size_t idle() const { return objects.size(); }
+    std::size_t maxIdle() const { return limit; }
+
+private:
+    static std::unique_ptr<Class> create();
+    void release(Class* obj);
+
+    std::vector<std::unique_ptr<Class>> objects;
+    std::size_t limit;
+    reset_policy policy;
+};
+
+}
+
+#include "Pool.inl"
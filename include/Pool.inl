@@ -0,0 +1,144 @@
+#include <type_traits>
+#include <utility>
+
+namespace meta
+{
+
+namespace detail
+{
+
+template <typename T, typename = void>
+struct has_clear : std::false_type { };
+
+template <typename T>
+struct has_clear<T, std::void_t<decltype(std::declval<T&>().clear())>> : std::true_type { };
+
+template <typename T>
+void resetValue(T& value, reset_policy policy);
+
+template <typename T, typename A>
+void resetValue(std::vector<T, A>& value, reset_policy policy);
+
+template <typename K, typename V, typename H, typename E, typename A>
+void resetValue(std::unordered_map<K, V, H, E, A>& value, reset_policy policy);
+
+template <typename T>
+void resetValue(T& value, reset_policy policy)
+{
+    if constexpr (isRegistered<T>()) {
+        resetMembers(value, policy);
+    } else if constexpr (has_clear<T>::value) {
+        value.clear(); // strings and containers keep their storage
+    } else {
+        value = T();
+    }
+}
+
+template <typename T, typename A>
+void resetValue(std::vector<T, A>& value, reset_policy policy)
+{
+    // elements without storage of their own are just overwritten by readers, but not kept
+    if constexpr (isRegistered<T>() || has_clear<T>::value) {
+        if (policy == reset_policy::keepElements) {
+            for (auto& elem : value) {
+                resetValue(elem, policy);
+            }
+            return;
+        }
+    }
+    value.clear();
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void resetValue(std::unordered_map<K, V, H, E, A>& value, reset_policy policy)
+{
+    if (policy == reset_policy::keepElements) {
+        for (auto& pair : value) { // map nodes and keys are kept too
+            resetValue(pair.second, policy);
+        }
+    } else {
+        value.clear();
+    }
+}
+
+} // end of namespace detail
+
+template <typename Class>
+void resetMembers(Class& obj, reset_policy policy)
+{
+    doForAllMembers<Class>(
+        [&obj, policy](const auto& member)
+        {
+            using MemberT = get_member_type<decltype(member)>;
+            if (member.canGetRef()) {
+                detail::resetValue(member.getRef(obj), policy);
+            } else if constexpr (std::is_default_constructible<MemberT>::value) {
+                member.set(obj, MemberT());
+            }
+        }
+    );
+}
+
+template <typename Class>
+void pool<Class>::deleter::operator()(Class* obj) const
+{
+    if (owner) {
+        owner->release(obj);
+    } else {
+        delete obj;
+    }
+}
+
+template <typename Class>
+pool<Class>::pool(std::size_t maxIdle, reset_policy policy) :
+    limit(maxIdle),
+    policy(policy)
+{
+    objects.reserve(limit); // release never reallocates
+}
+
+template <typename Class>
+typename pool<Class>::handle pool<Class>::acquire()
+{
+    if (objects.empty()) {
+        return handle(create().release(), deleter(this));
+    }
+    handle obj(objects.back().release(), deleter(this));
+    objects.pop_back();
+    return obj;
+}
+
+template <typename Class>
+void pool<Class>::reserve(std::size_t count)
+{
+    while (objects.size() < count && objects.size() < limit) {
+        objects.push_back(create());
+    }
+}
+
+template <typename Class>
+std::unique_ptr<Class> pool<Class>::create()
+{
+    if constexpr (std::is_default_constructible<Class>::value) {
+        return std::make_unique<Class>();
+    } else {
+        return std::make_unique<Class>(constructWith<Class>(
+            [](const auto& member)
+            {
+                return get_member_type<decltype(member)>();
+            }
+        ));
+    }
+}
+
+template <typename Class>
+void pool<Class>::release(Class* obj)
+{
+    std::unique_ptr<Class> owned(obj);
+    if (objects.size() < limit) {
+        resetMembers(*owned, policy);
+        objects.push_back(std::move(owned));
+    }
+}
+
+}
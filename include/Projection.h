@@ -0,0 +1,88 @@
+/* -----------------------------------------------------------------------------------------------
+
+meta::Projection<Class> is a set of members of Class selected by name, so serializers can process
+only a few members of a big class and skip everything else:
+
+    static const auto nameAndSalary = meta::fields<Person>("name", "salary");
+    Json::Value value = Json::serialize(person, nameAndSalary);
+
+Paths with dots select members of nested registered classes. Containers are looked through,
+so "favouriteMovies.rating" selects rating of each MovieInfo in
+std::unordered_map<std::string, std::vector<MovieInfo>> favouriteMovies.
+Selecting a member without a path ("favouriteMovies") selects it whole.
+
+Names are resolved to member indices when projection is constructed (unknown names throw
+std::runtime_error), so construct it once and reuse it.
+
+-------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Meta.h"
+
+namespace meta
+{
+
+// Class which nested projection of member of type T applies to:
+// T itself, element type for vectors and value type for unordered_maps
+template <typename T>
+struct projected_class {
+    using type = T;
+};
+
+template <typename T, typename A>
+struct projected_class<std::vector<T, A>> : projected_class<T> { };
+
+template <typename K, typename V, typename H, typename E, typename A>
+struct projected_class<std::unordered_map<K, V, H, E, A>> : projected_class<V> { };
+
+template <typename T>
+using projected_class_t = typename projected_class<T>::type;
+
+template <typename Class>
+class Projection {
+public:
+    explicit Projection(const std::vector<std::string_view>& paths);
+
+    // number of selected members
+    std::size_t size() const { return indices.size(); }
+    bool contains(std::size_t index) const { return selected[index]; }
+    // indices of selected members in registration order
+    const std::vector<std::size_t>& getIndices() const { return indices; }
+
+    // projection for member at index or nullptr if member is selected whole.
+    // T should be projected_class_t of member type
+    template <typename T>
+    const Projection<T>* getNested(std::size_t index) const
+    {
+        return static_cast<const Projection<T>*>(nested[index].get());
+    }
+
+private:
+    std::array<bool, getMemberCount<Class>()> selected{};
+    std::array<std::shared_ptr<const void>, getMemberCount<Class>()> nested;
+    std::vector<std::size_t> indices;
+};
+
+template <typename Class, typename... Paths>
+Projection<Class> fields(const Paths&... paths);
+
+// calls f(member) for selected members in registration order
+template <typename Class, typename F>
+void doForAllMembers(const Projection<Class>& projection, F&& f);
+
+// calls f(member, nested) for selected members in registration order, nested is
+// const Projection<projected_class_t<MemberT>>* or nullptr if member is selected whole
+template <typename Class, typename F>
+void doForProjectedMembers(const Projection<Class>& projection, F&& f);
+
+}
+
+#include "Projection.inl"
@@ -0,0 +1,82 @@
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace meta
+{
+
+template <typename Class>
+Projection<Class>::Projection(const std::vector<std::string_view>& paths)
+{
+    static_assert(isRegistered<Class>(), "Class is not registered");
+    std::array<std::vector<std::string_view>, getMemberCount<Class>()> nestedPaths;
+    std::array<bool, getMemberCount<Class>()> whole{};
+    for (const auto path : paths) {
+        const auto dot = path.find('.');
+        const auto name = path.substr(0, dot);
+        const auto index = memberIndex<Class>(name);
+        if (index == npos) {
+            throw std::runtime_error("Error: can't make projection, class has no member '" + std::string(name) + "'");
+        }
+        selected[index] = true;
+        if (dot == std::string_view::npos) {
+            whole[index] = true;
+        } else {
+            nestedPaths[index].push_back(path.substr(dot + 1));
+        }
+    }
+    for (std::size_t index = 0; index < selected.size(); ++index) {
+        if (!selected[index]) {
+            continue;
+        }
+        indices.push_back(index);
+        if (whole[index]) {
+            continue; // selecting member whole overrides its paths
+        }
+        detail::for_tuple_at(index,
+            [this, index, &nestedPaths](const auto& member)
+            {
+                using Nested = projected_class_t<get_member_type<decltype(member)>>;
+                if constexpr (isRegistered<Nested>()) {
+                    nested[index] = std::make_shared<Projection<Nested>>(nestedPaths[index]);
+                } else {
+                    throw std::runtime_error("Error: can't make projection, member '" +
+                        std::string(member.getNameView()) + "' has no nested members");
+                }
+            },
+            getMembers<Class>()
+        );
+    }
+}
+
+template <typename Class, typename... Paths>
+Projection<Class> fields(const Paths&... paths)
+{
+    return Projection<Class>(std::vector<std::string_view>{ std::string_view(paths)... });
+}
+
+template <typename Class, typename F>
+void doForAllMembers(const Projection<Class>& projection, F&& f)
+{
+    for (const auto index : projection.getIndices()) {
+        detail::for_tuple_at(index, f, getMembers<Class>());
+    }
+}
+
+template <typename Class, typename F>
+void doForProjectedMembers(const Projection<Class>& projection, F&& f)
+{
+    for (const auto index : projection.getIndices()) {
+        detail::for_tuple_at(index,
+            [&f, &projection, index](const auto& member)
+            {
+                using Nested = projected_class_t<get_member_type<decltype(member)>>;
+                f(member, projection.template getNested<Nested>(index));
+            },
+            getMembers<Class>()
+        );
+    }
+}
+
+}
@@ -0,0 +1,213 @@
+/* -----------------------------------------------------------------------------------------------
+
+meta::soa_vector<Class> is a structure of arrays container: it stores one contiguous array
+(column) per registered member of Class instead of array of Class objects, so loops which touch
+only a few members read only memory they need and can be vectorized.
+
+All members of Class should be registered as data member pointers, Class should be default
+constructible (it's used when rows are loaded: row.load() or Class c = soa[i];)
+
+    meta::soa_vector<Particle> particles;
+    particles.push_back(particle);
+
+    auto xs = particles.column(&Particle::x); // column_span<float>, contiguous
+    auto vs = particles.column<1>();          // column of the second registered member
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] += vs[i] * dt;
+    }
+
+    particles[i].get(&Particle::x) = 1.f;     // row proxy, AoS style access
+    Particle p = particles[i];
+
+Columns are std::vectors available through columnVector<I>(), so they can be serialized in bulk,
+e.g. Binary::serialize(particles.columnVector<0>()) is a single memcpy for number columns.
+
+Bool members are stored as meta::soa_bool, one byte per element which converts to and from bool,
+because std::vector<bool> packs bits: its elements can't be referenced through spans and rows,
+and neighbouring rows can't be written from different threads.
+
+-------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Meta.h"
+
+namespace meta
+{
+
+// View of contiguous column
+template <typename T>
+class column_span {
+public:
+    column_span(T* data, std::size_t size) : ptr(data), count(size) { }
+
+    T* data() const { return ptr; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T& operator[](std::size_t i) const { return ptr[i]; }
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + count; }
+private:
+    T* ptr;
+    std::size_t count;
+};
+
+// Element of bool column
+struct soa_bool {
+    soa_bool(bool value = false) : value(value) { }
+    operator bool() const { return value; }
+
+    bool value;
+};
+
+namespace detail
+{
+
+template <typename T>
+struct soa_element {
+    using type = T;
+};
+
+template <>
+struct soa_element<bool> {
+    using type = soa_bool;
+};
+
+} // end of namespace detail
+
+// type of column elements for member of type T
+template <typename T>
+using soa_element_t = typename detail::soa_element<T>::type;
+
+namespace detail
+{
+
+template <typename TupleType>
+struct soa_columns;
+
+template <typename... Members>
+struct soa_columns<std::tuple<Members...>> {
+    using type = std::tuple<std::vector<soa_element_t<get_member_type<Members>>>...>;
+    static constexpr bool allDataMembers = ((std::decay_t<Members>::access_kind == AccessKind::DataMember) && ...);
+};
+
+} // end of namespace detail
+
+template <typename Class>
+class soa_vector {
+    using members_info = detail::soa_columns<std::decay_t<decltype(registerMembers<Class>())>>;
+    static_assert(isRegistered<Class>(), "Class is not registered");
+    static_assert(members_info::allDataMembers, "soa_vector needs all members of Class to be data member pointers");
+public:
+    using columns_type = typename members_info::type;
+    static constexpr std::size_t columnCount = std::tuple_size<columns_type>::value;
+
+    template <std::size_t I>
+    using column_type = typename std::tuple_element_t<I, columns_type>::value_type;
+
+    // Proxy for a row, valid while the row exists. Assigning rows copies their values, like
+    // assigning elements of std::vector would
+    template <typename SoaVector>
+    class basic_row {
+    public:
+        basic_row(SoaVector& soa, std::size_t index) : soa(&soa), index(index) { }
+        basic_row(const basic_row&) = default;
+
+        template <std::size_t I>
+        auto& get() const { return std::get<I>(soa->columns)[index]; }
+        // finds column by member pointer, see soa_vector::column
+        template <typename T>
+        auto& get(T Class::* ptr) const { return soa->column(ptr)[index]; }
+
+        Class load() const { return soa->load(index); }
+        operator Class() const { return load(); }
+
+        template <typename S = SoaVector, typename = std::enable_if_t<!std::is_const<S>::value>>
+        const basic_row& operator=(const Class& obj) const
+        {
+            soa->store(index, obj);
+            return *this;
+        }
+
+        const basic_row& operator=(const basic_row& other) const
+        {
+            static_assert(!std::is_const<SoaVector>::value, "Row of const soa_vector can't be assigned");
+            soa->copyRow(index, *other.soa, other.index);
+            return *this;
+        }
+
+        template <typename S = SoaVector, typename = std::enable_if_t<!std::is_const<S>::value>>
+        const basic_row& operator=(const basic_row<const soa_vector>& other) const
+        {
+            soa->copyRow(index, *other.soa, other.index);
+            return *this;
+        }
+    private:
+        template <typename>
+        friend class basic_row;
+
+        SoaVector* soa;
+        std::size_t index;
+    };
+
+    using row = basic_row<soa_vector>;
+    using const_row = basic_row<const soa_vector>;
+
+    std::size_t size() const { return std::get<0>(columns).size(); }
+    bool empty() const { return size() == 0; }
+    void reserve(std::size_t capacity);
+    void resize(std::size_t count);
+    void clear();
+
+    void push_back(const Class& obj);
+    void pop_back();
+
+    row operator[](std::size_t index) { return row(*this, index); }
+    const_row operator[](std::size_t index) const { return const_row(*this, index); }
+
+    // gathers members of row into Class object
+    Class load(std::size_t index) const;
+    // scatters members of obj to row
+    void store(std::size_t index, const Class& obj);
+
+    template <std::size_t I>
+    column_span<column_type<I>> column();
+    template <std::size_t I>
+    column_span<const column_type<I>> column() const;
+
+    // column of member registered with ptr. Member is found with a linear search over members,
+    // so get the span once before the loop. Throws std::runtime_error if ptr is not registered
+    template <typename T>
+    column_span<soa_element_t<T>> column(T Class::* ptr);
+    template <typename T>
+    column_span<const soa_element_t<T>> column(T Class::* ptr) const;
+
+    template <std::size_t I>
+    const std::vector<column_type<I>>& columnVector() const { return std::get<I>(columns); }
+
+private:
+    template <typename T>
+    std::size_t findColumn(T Class::* ptr) const;
+
+    // copies values of row fromIndex of 'from' column by column, 'from' can be *this
+    void copyRow(std::size_t index, const soa_vector& from, std::size_t fromIndex);
+
+    // calls f(member, column) for each member
+    template <typename F>
+    void forEachColumn(F&& f);
+    template <typename F>
+    void forEachColumn(F&& f) const;
+
+    columns_type columns;
+};
+
+} // end of namespace meta
+
+#include "SoaVector.inl"
@@ -0,0 +1,161 @@
+#include <stdexcept>
+#include <type_traits>
+
+namespace meta
+{
+
+namespace detail
+{
+
+template <typename Members, typename Columns, typename F, std::size_t... I>
+void for_each_column(const Members& members, Columns& columns, F&& f, std::index_sequence<I...>)
+{
+    (f(std::get<I>(members), std::get<I>(columns)), ...);
+}
+
+template <typename Columns, std::size_t... I>
+void copy_row(Columns& to, std::size_t toIndex, const Columns& from, std::size_t fromIndex, std::index_sequence<I...>)
+{
+    ((std::get<I>(to)[toIndex] = std::get<I>(from)[fromIndex]), ...);
+}
+
+} // end of namespace detail
+
+template <typename Class>
+template <typename F>
+void soa_vector<Class>::forEachColumn(F&& f)
+{
+    detail::for_each_column(getMembers<Class>(), columns, std::forward<F>(f), std::make_index_sequence<columnCount>());
+}
+
+template <typename Class>
+template <typename F>
+void soa_vector<Class>::forEachColumn(F&& f) const
+{
+    detail::for_each_column(getMembers<Class>(), columns, std::forward<F>(f), std::make_index_sequence<columnCount>());
+}
+
+template <typename Class>
+void soa_vector<Class>::reserve(std::size_t capacity)
+{
+    forEachColumn([capacity](const auto&, auto& column) { column.reserve(capacity); });
+}
+
+template <typename Class>
+void soa_vector<Class>::resize(std::size_t count)
+{
+    forEachColumn([count](const auto&, auto& column) { column.resize(count); });
+}
+
+template <typename Class>
+void soa_vector<Class>::clear()
+{
+    forEachColumn([](const auto&, auto& column) { column.clear(); });
+}
+
+template <typename Class>
+void soa_vector<Class>::push_back(const Class& obj)
+{
+    forEachColumn([&obj](const auto& member, auto& column) { column.push_back(member.get(obj)); });
+}
+
+template <typename Class>
+void soa_vector<Class>::pop_back()
+{
+    forEachColumn([](const auto&, auto& column) { column.pop_back(); });
+}
+
+template <typename Class>
+Class soa_vector<Class>::load(std::size_t index) const
+{
+    Class obj{};
+    forEachColumn([&obj, index](const auto& member, const auto& column) { member.getRef(obj) = column[index]; });
+    return obj;
+}
+
+template <typename Class>
+void soa_vector<Class>::store(std::size_t index, const Class& obj)
+{
+    forEachColumn([&obj, index](const auto& member, auto& column) { column[index] = member.get(obj); });
+}
+
+template <typename Class>
+void soa_vector<Class>::copyRow(std::size_t index, const soa_vector& from, std::size_t fromIndex)
+{
+    detail::copy_row(columns, index, from.columns, fromIndex, std::make_index_sequence<columnCount>());
+}
+
+template <typename Class>
+template <std::size_t I>
+column_span<typename soa_vector<Class>::template column_type<I>> soa_vector<Class>::column()
+{
+    auto& column = std::get<I>(columns);
+    return { column.data(), column.size() };
+}
+
+template <typename Class>
+template <std::size_t I>
+column_span<const typename soa_vector<Class>::template column_type<I>> soa_vector<Class>::column() const
+{
+    auto& column = std::get<I>(columns);
+    return { column.data(), column.size() };
+}
+
+template <typename Class>
+template <typename T>
+std::size_t soa_vector<Class>::findColumn(T Class::* ptr) const
+{
+    std::size_t index = 0;
+    const bool found = doForAllMembersUntil<Class>(
+        [ptr, &index](const auto& member)
+        {
+            if constexpr (std::is_same<get_member_type<decltype(member)>, T>::value) {
+                if (member.getPtr() == ptr) {
+                    return true;
+                }
+            }
+            ++index;
+            return false;
+        }
+    );
+    if (!found) {
+        throw std::runtime_error("Error: member pointer is not registered for this class");
+    }
+    return index;
+}
+
+template <typename Class>
+template <typename T>
+column_span<soa_element_t<T>> soa_vector<Class>::column(T Class::* ptr)
+{
+    soa_element_t<T>* data = nullptr;
+    detail::for_tuple_at(findColumn(ptr),
+        [&data](auto& column)
+        {
+            if constexpr (std::is_same<std::decay_t<decltype(column)>, std::vector<soa_element_t<T>>>::value) {
+                data = column.data();
+            }
+        },
+        columns
+    );
+    return { data, size() };
+}
+
+template <typename Class>
+template <typename T>
+column_span<const soa_element_t<T>> soa_vector<Class>::column(T Class::* ptr) const
+{
+    const soa_element_t<T>* data = nullptr;
+    detail::for_tuple_at(findColumn(ptr),
+        [&data](const auto& column)
+        {
+            if constexpr (std::is_same<std::decay_t<decltype(column)>, std::vector<soa_element_t<T>>>::value) {
+                data = column.data();
+            }
+        },
+        columns
+    );
+    return { data, size() };
+}
+
+} // end of namespace meta
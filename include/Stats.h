@@ -0,0 +1,120 @@
+/* -----------------------------------------------------------------------------------------------
+
+Optional instrumentation of reflection and serialization: per-class and per-member counters which
+show where time and bytes go. It's compiled out unless META_ENABLE_STATS is defined (define it for
+the whole project, e.g. with -DMETA_ENABLE_STATS, so all translation units agree). Without it
+hooks are empty and counters stay zero, so code which exports them doesn't need #ifdefs:
+
+    for (const meta::class_stats* s : meta::allStats()) {
+        metrics.counter(std::string(s->name) + ".serialize.ns", s->serializeNanos.load());
+        for (const auto& m : s->members) {
+            metrics.counter(std::string(s->name) + "." + std::string(m.name) + ".setter", m.setterWrites.load());
+        }
+    }
+
+Counted:
+- memberIterations: calls of doForAllMembers and doForAllMembersUntil for the class
+- serialize/deserialize calls, time and bytes of registered objects in Json (Json::Value,
+  JsonWriter, JsonReader) and Binary backends. Time is inclusive: time of Person includes
+  time of its nested MovieInfo objects. Json::Value is not text, so DOM calls add no bytes
+- per member: decoded values passed to setters vs. decoded in place through references
+
+Counters are relaxed atomics, so they can be read while other threads serialize.
+Classes appear in allStats() after their first counted event (or stats<Class>() call).
+This file is included by Meta.h.
+
+-------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace meta
+{
+
+#ifdef META_ENABLE_STATS
+constexpr bool statsEnabled = true;
+#else
+constexpr bool statsEnabled = false;
+#endif
+
+struct member_stats {
+    std::string_view name;
+    std::atomic<std::uint64_t> setterWrites{ 0 };
+    std::atomic<std::uint64_t> refWrites{ 0 };
+};
+
+struct class_stats {
+    // registered name (see registerName) or "unnamed" if class has none
+    std::string_view name;
+
+    std::atomic<std::uint64_t> memberIterations{ 0 };
+    std::atomic<std::uint64_t> serializeCalls{ 0 };
+    std::atomic<std::uint64_t> serializeNanos{ 0 };
+    std::atomic<std::uint64_t> bytesWritten{ 0 };
+    std::atomic<std::uint64_t> deserializeCalls{ 0 };
+    std::atomic<std::uint64_t> deserializeNanos{ 0 };
+    std::atomic<std::uint64_t> bytesRead{ 0 };
+
+    // in getMembers<Class>() order
+    std::vector<member_stats> members;
+};
+
+template <typename Class>
+const class_stats& stats();
+
+// stats of all classes which have been counted so far
+std::vector<const class_stats*> allStats();
+
+// zeroes all counters
+void resetStats();
+
+namespace detail
+{
+
+enum class StatsOp { Serialize, Deserialize };
+
+template <typename Class>
+class_stats& mutableStats();
+
+template <typename Class>
+constexpr void countMemberIteration();
+
+// decoded value of member with index (position in registerMembers) was passed to setter or decoded
+// through reference. Callers iterate members anyway, so they pass index instead of a name to look up
+template <typename Class>
+void countMemberWrite(std::size_t index, bool viaSetter);
+
+// Counts one call and its time from construction to destruction. position() returns number of
+// bytes written or read so far, difference between its values at the end and at the start is counted
+template <typename Class, typename Position>
+class stats_scope {
+public:
+    stats_scope(StatsOp op, Position position);
+    ~stats_scope();
+
+    stats_scope(const stats_scope&) = delete;
+    stats_scope& operator=(const stats_scope&) = delete;
+private:
+    StatsOp op;
+    Position position;
+    std::size_t startPosition;
+    std::int64_t startNanos;
+};
+
+struct no_position {
+    std::size_t operator()() const { return 0; }
+};
+
+template <typename Class, typename Position = no_position>
+stats_scope<Class, Position> countScope(StatsOp op, Position position = Position());
+
+} // end of namespace detail
+
+}
+
+#include "Stats.inl"
@@ -0,0 +1,136 @@
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace meta
+{
+
+namespace detail
+{
+
+struct stats_registry {
+    std::mutex mutex;
+    std::vector<class_stats*> classes;
+};
+
+inline stats_registry& statsRegistry()
+{
+    static stats_registry registry;
+    return registry;
+}
+
+template <typename Class>
+std::unique_ptr<class_stats> makeStats()
+{
+    auto result = std::make_unique<class_stats>();
+    const std::string_view registered = registerName<Class>();
+    result->name = registered.empty() ? std::string_view("unnamed") : registered; // no RTTI for typeid
+    result->members = std::vector<member_stats>(getMemberCount<Class>());
+    std::size_t index = 0;
+    for_tuple(
+        [&result, &index](const auto& member)
+        {
+            result->members[index++].name = member.getNameView();
+        },
+        getMembers<Class>()
+    );
+    std::lock_guard<std::mutex> lock(statsRegistry().mutex);
+    statsRegistry().classes.push_back(result.get());
+    return result;
+}
+
+template <typename Class>
+class_stats& mutableStats()
+{
+    static const std::unique_ptr<class_stats> stats = makeStats<Class>(); // never freed, see allStats
+    return *stats;
+}
+
+inline std::int64_t statsNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename Class>
+constexpr void countMemberIteration()
+{
+    if constexpr (statsEnabled) {
+        mutableStats<Class>().memberIterations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename Class>
+void countMemberWrite(std::size_t index, bool viaSetter)
+{
+    if constexpr (statsEnabled) {
+        auto& counters = mutableStats<Class>().members[index];
+        (viaSetter ? counters.setterWrites : counters.refWrites).fetch_add(1, std::memory_order_relaxed);
+    } else {
+        (void)index;
+        (void)viaSetter;
+    }
+}
+
+template <typename Class, typename Position>
+stats_scope<Class, Position>::stats_scope(StatsOp op, Position position) :
+    op(op), position(position), startPosition(0), startNanos(0)
+{
+    if constexpr (statsEnabled) {
+        startPosition = this->position();
+        startNanos = statsNow();
+    }
+}
+
+template <typename Class, typename Position>
+stats_scope<Class, Position>::~stats_scope()
+{
+    if constexpr (statsEnabled) {
+        const auto nanos = static_cast<std::uint64_t>(statsNow() - startNanos);
+        const auto bytes = static_cast<std::uint64_t>(position() - startPosition);
+        auto& counters = mutableStats<Class>();
+        const bool serialize = op == StatsOp::Serialize;
+        (serialize ? counters.serializeCalls : counters.deserializeCalls).fetch_add(1, std::memory_order_relaxed);
+        (serialize ? counters.serializeNanos : counters.deserializeNanos).fetch_add(nanos, std::memory_order_relaxed);
+        (serialize ? counters.bytesWritten : counters.bytesRead).fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+template <typename Class, typename Position>
+stats_scope<Class, Position> countScope(StatsOp op, Position position)
+{
+    return stats_scope<Class, Position>(op, position);
+}
+
+} // end of namespace detail
+
+template <typename Class>
+const class_stats& stats()
+{
+    return detail::mutableStats<Class>();
+}
+
+inline std::vector<const class_stats*> allStats()
+{
+    auto& registry = detail::statsRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return std::vector<const class_stats*>(registry.classes.begin(), registry.classes.end());
+}
+
+inline void resetStats()
+{
+    auto& registry = detail::statsRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (class_stats* counters : registry.classes) {
+        for (auto* counter : { &counters->memberIterations, &counters->serializeCalls, &counters->serializeNanos,
+            &counters->bytesWritten, &counters->deserializeCalls, &counters->deserializeNanos, &counters->bytesRead }) {
+            counter->store(0, std::memory_order_relaxed);
+        }
+        for (auto& member : counters->members) {
+            member.setterWrites.store(0, std::memory_order_relaxed);
+            member.refWrites.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+}
@@ -3,29 +3,102 @@
 MetaHolder holds all Member objects constructed via meta::registerMembers<T> call.
 If the class is not registered, members is std::tuple<>
 
+nameIndex maps member names to their indices in members tuple, see NameIndex.h
+accessors is array of type erased MemberAccessor<T>, one per member
+
+If registerMembers<T>() is constexpr, all of them are constants built by the compiler (see
+ConstexprTables), so they're placed in read-only data and can be used in constant expressions.
+Otherwise they're function-local statics: they're constructed on first use (nothing is done at
+startup for classes which are never used), initialization is thread-safe and they can be used
+during static initialization of other translation units.
+
 -------------------------------------------------------------------------------------------------*/
 
 #pragma once
 
+#include <array>
 #include <tuple>
+#include <type_traits>
+
+#include "NameIndex.h"
 
 namespace meta
 {
 namespace detail
 {
 
+// Check if registerMembers<T>() can be evaluated at compile time
+template <typename T, typename = void>
+struct is_constexpr_registered : std::false_type { };
+
+template <typename T>
+struct is_constexpr_registered<T, std::void_t<std::integral_constant<bool, (registerMembers<T>(), true)>>> :
+    std::true_type { };
+
+template <typename T, typename TupleType>
+struct ConstexprTables {
+    static constexpr std::size_t memberCount = std::tuple_size<TupleType>::value;
+
+    static constexpr TupleType members = registerMembers<T>();
+    static constexpr NameIndex<memberCount> nameIndex{ members };
+    static constexpr std::array<MemberAccessor<T>, memberCount> accessors = makeMemberAccessors<T>(members);
+};
+
 template <typename T, typename TupleType>
 struct MetaHolder {
-    static TupleType members;
+    static constexpr std::size_t memberCount = std::tuple_size<TupleType>::value;
+    static constexpr bool isConstexpr = is_constexpr_registered<T>::value;
+
+    static constexpr const TupleType& members()
+    {
+        if constexpr (isConstexpr) {
+            return ConstexprTables<T, TupleType>::members;
+        } else {
+            return lazyMembers();
+        }
+    }
+
+    static constexpr const NameIndex<memberCount>& nameIndex()
+    {
+        if constexpr (isConstexpr) {
+            return ConstexprTables<T, TupleType>::nameIndex;
+        } else {
+            return lazyNameIndex();
+        }
+    }
+
+    static constexpr const std::array<MemberAccessor<T>, memberCount>& accessors()
+    {
+        if constexpr (isConstexpr) {
+            return ConstexprTables<T, TupleType>::accessors;
+        } else {
+            return lazyAccessors();
+        }
+    }
+
+    static const TupleType& lazyMembers()
+    {
+        static const TupleType members = registerMembers<T>();
+        return members;
+    }
+
+    static const NameIndex<memberCount>& lazyNameIndex()
+    {
+        static const NameIndex<memberCount> nameIndex{ members() };
+        return nameIndex;
+    }
+
+    static const std::array<MemberAccessor<T>, memberCount>& lazyAccessors()
+    {
+        static const auto accessors = makeMemberAccessors<T>(members());
+        return accessors;
+    }
+
     static const char* name() 
     {
         return registerName<T>();
     }
 };
 
-template <typename T, typename TupleType>
-TupleType MetaHolder<T, TupleType>::members = registerMembers<T>();
-
-
 } // end of namespace detail
 } // end of namespace meta
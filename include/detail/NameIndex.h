@@ -0,0 +1,118 @@
+/* -----------------------------------------------------------------------------------------------
+
+NameIndex<N> maps member names of a registered class to indices in its member tuple.
+It's built once per class by MetaHolder, after that lookups don't depend on number of members.
+Everything is constexpr, so index of class with constexpr registerMembers is built at compile time
+and names can be looked up in constant expressions.
+
+Table is open addressed with linear probing and kept at most half full, so lookup is
+usually a single hash comparison followed by one string comparison.
+
+-------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "string_hash.h"
+
+namespace meta
+{
+namespace detail
+{
+
+constexpr std::size_t nextPowerOfTwo(std::size_t n)
+{
+    std::size_t p = 1;
+    while (p < n) {
+        p *= 2;
+    }
+    return p;
+}
+
+template <std::size_t N>
+class NameIndex {
+public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    template <typename TupleType>
+    constexpr explicit NameIndex(const TupleType& members);
+
+    // returns index of the member in tuple or npos
+    constexpr std::size_t find(std::string_view name) const;
+    constexpr std::size_t find(std::string_view name, name_hash_t hash) const;
+
+private:
+    static constexpr std::size_t tableSize = nextPowerOfTwo(2 * N + 1);
+    static constexpr std::uint32_t emptySlot = std::numeric_limits<std::uint32_t>::max();
+
+    struct Slot {
+        name_hash_t hash;
+        std::uint32_t index;
+    };
+
+    template <typename TupleType, std::size_t... I>
+    constexpr void fill(const TupleType& members, std::index_sequence<I...>);
+    constexpr void insert(std::string_view name, name_hash_t hash, std::uint32_t index);
+
+    std::array<std::string_view, N> names{};
+    std::array<Slot, tableSize> slots{};
+};
+
+template <std::size_t N>
+template <typename TupleType>
+constexpr NameIndex<N>::NameIndex(const TupleType& members)
+{
+    static_assert(std::tuple_size<TupleType>::value == N, "Wrong number of members");
+    for (auto& slot : slots) {
+        slot = Slot{ 0, emptySlot };
+    }
+    fill(members, std::make_index_sequence<N>());
+}
+
+template <std::size_t N>
+template <typename TupleType, std::size_t... I>
+constexpr void NameIndex<N>::fill(const TupleType& members, std::index_sequence<I...>)
+{
+    (void)members; // unused for classes without members
+    (insert(std::get<I>(members).getNameView(), std::get<I>(members).getNameHash(), I), ...);
+}
+
+template <std::size_t N>
+constexpr void NameIndex<N>::insert(std::string_view name, name_hash_t hash, std::uint32_t index)
+{
+    names[index] = name;
+    std::size_t i = hash & (tableSize - 1);
+    while (slots[i].index != emptySlot) {
+        i = (i + 1) & (tableSize - 1);
+    }
+    slots[i] = Slot{ hash, index };
+}
+
+template <std::size_t N>
+constexpr std::size_t NameIndex<N>::find(std::string_view name) const
+{
+    return find(name, hashString(name));
+}
+
+template <std::size_t N>
+constexpr std::size_t NameIndex<N>::find(std::string_view name, name_hash_t hash) const
+{
+    std::size_t i = hash & (tableSize - 1);
+    while (slots[i].index != emptySlot) {
+        const auto& slot = slots[i];
+        if (slot.hash == hash && names[slot.index] == name) {
+            return slot.index;
+        }
+        i = (i + 1) & (tableSize - 1);
+    }
+    return npos;
+}
+
+} // end of namespace detail
+} // end of namespace meta
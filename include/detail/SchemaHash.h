@@ -0,0 +1,188 @@
+/* -----------------------------------------------------------------------------------------------
+
+Structural hashing of types, used by meta::schemaHash<T>()
+
+Types are described by their shape instead of compiler specific names, so the same schema gives
+the same hash everywhere:
+- bool, char, signed/unsigned integers and floating point numbers of each size have their own tags
+- enums are hashed as their underlying type
+- strings, vectors and unordered maps are hashed by kind and element types (allocators are ignored)
+- registered classes are hashed by registered name, number of members and then name and type of
+  each member in registration order. Classes which contain themselves (e.g. vector of child nodes)
+  refer to the enclosing class by its depth instead of hashing it again
+- other types only contribute "unknown type" tag
+
+Strings are hashed with their length, so "ab" + "c" and "a" + "bc" are different.
+
+-------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace meta
+{
+namespace detail
+{
+
+using schema_hash_t = std::uint64_t;
+
+// 64-bit FNV-1a
+class SchemaHasher {
+public:
+    constexpr void add(char tag)
+    {
+        hash ^= static_cast<unsigned char>(tag);
+        hash *= 1099511628211ull;
+    }
+    constexpr void add(std::uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i) {
+            add(static_cast<char>(value >> (8 * i)));
+        }
+    }
+    constexpr void add(std::string_view str)
+    {
+        add(static_cast<std::uint64_t>(str.size()));
+        for (char c : str) {
+            add(c);
+        }
+    }
+    constexpr schema_hash_t get() const { return hash; }
+private:
+    schema_hash_t hash = 14695981039346656037ull;
+};
+
+// ClassStack holds registered classes which are being hashed, innermost last.
+// It's a type, so recursive classes are detected at compile time
+template <typename... Classes>
+struct ClassStack { };
+
+// distance from the top of the stack to Class (1 for innermost class) or 0 if it's not in stack
+template <typename Class, typename... Classes>
+constexpr std::size_t stackDepth(ClassStack<Classes...>)
+{
+    constexpr bool same[] = { std::is_same<Class, Classes>::value..., false };
+    for (std::size_t i = 0; i < sizeof...(Classes); ++i) {
+        if (same[i]) {
+            return sizeof...(Classes) - i;
+        }
+    }
+    return 0;
+}
+
+template <typename T, typename... Classes>
+constexpr void addTypeSchema(SchemaHasher& hasher, ClassStack<Classes...> stack, const T*);
+
+template <typename Traits, typename Alloc, typename... Classes>
+constexpr void addTypeSchema(SchemaHasher& hasher, ClassStack<Classes...> stack, const std::basic_string<char, Traits, Alloc>*);
+
+template <typename T, typename A, typename... Classes>
+constexpr void addTypeSchema(SchemaHasher& hasher, ClassStack<Classes...> stack, const std::vector<T, A>*);
+
+template <typename K, typename V, typename H, typename E, typename A, typename... Classes>
+constexpr void addTypeSchema(SchemaHasher& hasher, ClassStack<Classes...> stack, const std::unordered_map<K, V, H, E, A>*);
+
+template <typename Class, typename... Classes>
+constexpr void addClassSchema(SchemaHasher& hasher, ClassStack<Classes...> /* stack */)
+{
+    constexpr std::size_t depth = stackDepth<Class>(ClassStack<Classes...>{});
+    if constexpr (depth != 0) {
+        hasher.add('r');
+        hasher.add(static_cast<std::uint64_t>(depth));
+    } else {
+        hasher.add('o');
+        hasher.add(std::string_view(registerName<Class>()));
+        hasher.add(static_cast<std::uint64_t>(getMemberCount<Class>()));
+        for_tuple( // not doForAllMembers, so schema hashing isn't counted in stats (see Stats.h)
+            [&hasher](const auto& member)
+            {
+                using MemberT = get_member_type<decltype(member)>;
+                hasher.add(member.getNameView());
+                addTypeSchema(hasher, ClassStack<Classes..., Class>{}, static_cast<const MemberT*>(nullptr));
+            },
+            getMembers<Class>()
+        );
+    }
+}
+
+template <typename T, typename... Classes>
+constexpr void addTypeSchema(SchemaHasher& hasher, ClassStack<Classes...> stack, const T*)
+{
+    if constexpr (isRegistered<T>()) {
+        addClassSchema<T>(hasher, stack);
+    } else if constexpr (std::is_enum<T>::value) {
+        addTypeSchema(hasher, stack, static_cast<const std::underlying_type_t<T>*>(nullptr));
+    } else if constexpr (std::is_same<T, bool>::value) {
+        hasher.add('b');
+    } else if constexpr (std::is_same<T, char>::value) {
+        hasher.add('c'); // signedness of char depends on platform
+    } else if constexpr (std::is_integral<T>::value) {
+        hasher.add(std::is_signed<T>::value ? 'i' : 'u');
+        hasher.add(static_cast<std::uint64_t>(sizeof(T)));
+    } else if constexpr (std::is_floating_point<T>::value) {
+        hasher.add('f');
+        hasher.add(static_cast<std::uint64_t>(sizeof(T)));
+    } else {
+        hasher.add('x');
+    }
+}
+
+template <typename Traits, typename Alloc, typename... Classes>
+constexpr void addTypeSchema(SchemaHasher& hasher, ClassStack<Classes...> /* stack */, const std::basic_string<char, Traits, Alloc>*)
+{
+    hasher.add('s');
+}
+
+template <typename T, typename A, typename... Classes>
+constexpr void addTypeSchema(SchemaHasher& hasher, ClassStack<Classes...> stack, const std::vector<T, A>*)
+{
+    hasher.add('v');
+    addTypeSchema(hasher, stack, static_cast<const T*>(nullptr));
+}
+
+template <typename K, typename V, typename H, typename E, typename A, typename... Classes>
+constexpr void addTypeSchema(SchemaHasher& hasher, ClassStack<Classes...> stack, const std::unordered_map<K, V, H, E, A>*)
+{
+    hasher.add('m');
+    addTypeSchema(hasher, stack, static_cast<const K*>(nullptr));
+    addTypeSchema(hasher, stack, static_cast<const V*>(nullptr));
+}
+
+template <typename T>
+constexpr schema_hash_t computeSchemaHash()
+{
+    SchemaHasher hasher;
+    addTypeSchema(hasher, ClassStack<>{}, static_cast<const T*>(nullptr));
+    return hasher.get();
+}
+
+// Check if schema hash of T can be computed at compile time:
+// all registered classes it depends on should have constexpr registerMembers
+template <typename T, typename = void>
+struct is_constant_schema : std::false_type { };
+
+template <typename T>
+struct is_constant_schema<T, std::void_t<std::integral_constant<schema_hash_t, computeSchemaHash<T>()>>> :
+    std::true_type { };
+
+template <typename T>
+struct constant_schema_hash {
+    static constexpr schema_hash_t value = computeSchemaHash<T>();
+};
+
+template <typename T>
+schema_hash_t cachedSchemaHash()
+{
+    static const schema_hash_t hash = computeSchemaHash<T>();
+    return hash;
+}
+
+} // end of namespace detail
+} // end of namespace meta
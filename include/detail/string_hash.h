@@ -0,0 +1,26 @@
+// String hashing used for member name lookups
+// Everything here is constexpr, so names known at compile time are hashed by the compiler
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace meta {
+namespace detail {
+
+using name_hash_t = std::uint32_t;
+
+// FNV-1a: cheap, good enough for short identifiers and works in constant expressions
+constexpr name_hash_t hashString(std::string_view str)
+{
+    name_hash_t hash = 2166136261u;
+    for (char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+} // end of namespace detail
+} // end of namespace meta
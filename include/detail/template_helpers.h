@@ -3,37 +3,32 @@
 
 #pragma once
 
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
 namespace meta {
 namespace detail {
 
 // for_each_arg - call f for each argument from pack
 template <typename F, typename... Args>
-void for_each_arg(F&& f, Args&&... args);
+constexpr void for_each_arg(F&& f, Args&&... args);
 
 // for_each_arg - call f for each element from tuple
 template <typename F, typename TupleT>
-void for_tuple(F&& f, TupleT&& tuple);
-
-// overload for empty tuple which does nothing
-template <typename F>
-void for_tuple(F&& f, const std::tuple<>& tuple);
-
-// calls F if condition is true
-// this is useful for templated lambdas, because they won't be
-// instantiated with unneeded types
-template <bool Test,
-    typename F, typename... Args,
-    typename = std::enable_if_t<Test>>
-void call_if(F&& f, Args&&... args);
-
-// calls F if condition is false
-template <bool Test,
-    typename F, typename... Args,
-    typename = std::enable_if_t<!Test>,
-    typename = void> // dummy type for difference between two functions
-void call_if(F&& f, Args&&... args);
+constexpr void for_tuple(F&& f, TupleT&& tuple);
+
+// for_tuple_until - call f for each element from tuple until it returns true
+// returns true if iteration was stopped by f
+template <typename F, typename TupleT>
+constexpr bool for_tuple_until(F&& f, TupleT&& tuple);
+
+// call f for element of tuple with runtime index 'index'
+// dispatched through a table of function pointers, index should be less than tuple size
+template <typename F, typename TupleT>
+void for_tuple_at(std::size_t index, F&& f, TupleT&& tuple);
 
 } // end of namespace detail
 } // end of namespace meta
 
-#include "template_helpers.inl"
\ No newline at end of file
+#include "template_helpers.inl"
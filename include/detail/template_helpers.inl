@@ -1,76 +1,53 @@
 namespace meta {
 namespace detail {
 
-template <typename F, typename... Args>
-void for_each_arg(F&& f, Args&&... args)
-{
-    // Waiting for C++17, so I don't have to write silly stuff like this
-    using expand = bool[];
-    (void)expand
-    {
-        (
-            f(std::forward<Args>(args)),
-            true
-        )...
-    };
-}
-
-template <size_t N>
-decltype(auto) makeIndexSequence()
-{
-    return std::make_index_sequence<N>();
-}
-
-// Because VS can't properly make index_sequence out of 1 element...
-// Seems to be fixed in VS 2015 Update 3
-
-template <>
-inline decltype(auto) makeIndexSequence<1>()
-{
-    return std::index_sequence<0>();
-}
+// All iteration is done with fold expressions over std::apply, so each call site instantiates
+// only the lambda it passes and std::apply, without recursive helper templates
 
-template <typename F, typename Tuple, size_t... I>
-decltype(auto) apply_impl(F&& f, Tuple&& t, std::index_sequence<I...>)
+template <typename F, typename... Args>
+constexpr void for_each_arg(F&& f, Args&&... args)
 {
-    return f(std::get<I>(std::forward<Tuple>(t))...);
+    (f(std::forward<Args>(args)), ...);
 }
 
-template <typename F, typename Tuple>
-decltype(auto) apply(F&& f, Tuple&& t)
+template <typename F, typename TupleT>
+constexpr void for_tuple(F&& f, TupleT&& tuple)
 {
-    constexpr size_t tupleSize = std::tuple_size<std::decay_t<Tuple>>::value;
-    return apply_impl(std::forward<F>(f), std::forward<Tuple>(t), makeIndexSequence<tupleSize>());
+    std::apply(
+        [&f](auto&&... elems) {
+            (f(std::forward<decltype(elems)>(elems)), ...);
+        },
+        std::forward<TupleT>(tuple));
 }
 
 template <typename F, typename TupleT>
-void for_tuple(F&& f, TupleT&& tuple)
+constexpr bool for_tuple_until(F&& f, TupleT&& tuple)
 {
-    apply(
+    return std::apply(
         [&f](auto&&... elems) {
-            for_each_arg(f,
-                         std::forward<decltype(elems)>(elems)...);
+            return (... || static_cast<bool>(f(std::forward<decltype(elems)>(elems))));
         },
         std::forward<TupleT>(tuple));
 }
 
-template <typename F>
-void for_tuple(F&& /* f */, const std::tuple<>& /* tuple */)
-{ /* do nothing */ }
-
-template <bool Test,
-    typename F, typename... Args,
-    typename>
-void call_if(F&& f, Args&&... args)
+template <typename F, typename TupleT, size_t... I>
+void for_tuple_at_impl(std::size_t index, F& f, TupleT& tuple, std::index_sequence<I...>)
 {
-    f(std::forward<Args>(args)...);
+    using thunk_t = void (*)(F&, TupleT&);
+    static constexpr thunk_t thunks[] = {
+        [](F& f, TupleT& tuple) { f(std::get<I>(tuple)); }...
+    };
+    thunks[index](f, tuple);
 }
 
-template <bool Test,
-    typename F, typename... Args,
-    typename, typename>
-void call_if(F&& /* f */, Args&&... /* args */)
-{ /* do nothing */ }
+template <typename F, typename TupleT>
+void for_tuple_at(std::size_t index, F&& f, TupleT&& tuple)
+{
+    constexpr size_t tupleSize = std::tuple_size<std::decay_t<TupleT>>::value;
+    if constexpr (tupleSize != 0) {
+        for_tuple_at_impl(index, f, tuple, std::make_index_sequence<tupleSize>());
+    }
+}
 
 } // end of namespace detail
-} // end of namespace meta
\ No newline at end of file
+} // end of namespace meta